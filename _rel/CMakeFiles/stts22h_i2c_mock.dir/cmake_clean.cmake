@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/stts22h_i2c_mock.dir/tests/mock/i2c.c.o"
+  "CMakeFiles/stts22h_i2c_mock.dir/tests/mock/i2c.c.o.d"
+  "libstts22h_i2c_mock.a"
+  "libstts22h_i2c_mock.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/stts22h_i2c_mock.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libstts22h_i2c_mock.a"
+)
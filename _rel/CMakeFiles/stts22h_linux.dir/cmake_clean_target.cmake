@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libstts22h_linux.a"
+)
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/stts22h_bench.dir/stts22h_bench.c.o"
+  "CMakeFiles/stts22h_bench.dir/stts22h_bench.c.o.d"
+  "stts22h_bench"
+  "stts22h_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/stts22h_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
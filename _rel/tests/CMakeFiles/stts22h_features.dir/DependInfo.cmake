@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/sources/stts22h.c" "tests/CMakeFiles/stts22h_features.dir/__/sources/stts22h.c.o" "gcc" "tests/CMakeFiles/stts22h_features.dir/__/sources/stts22h.c.o.d"
+  "/root/repo/sources/stts22h_bus.c" "tests/CMakeFiles/stts22h_features.dir/__/sources/stts22h_bus.c.o" "gcc" "tests/CMakeFiles/stts22h_features.dir/__/sources/stts22h_bus.c.o.d"
+  "/root/repo/sources/stts22h_fifo.c" "tests/CMakeFiles/stts22h_features.dir/__/sources/stts22h_fifo.c.o" "gcc" "tests/CMakeFiles/stts22h_features.dir/__/sources/stts22h_fifo.c.o.d"
+  "/root/repo/sources/stts22h_filter.c" "tests/CMakeFiles/stts22h_features.dir/__/sources/stts22h_filter.c.o" "gcc" "tests/CMakeFiles/stts22h_features.dir/__/sources/stts22h_filter.c.o.d"
+  "/root/repo/sources/stts22h_log.c" "tests/CMakeFiles/stts22h_features.dir/__/sources/stts22h_log.c.o" "gcc" "tests/CMakeFiles/stts22h_features.dir/__/sources/stts22h_log.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel/CMakeFiles/stts22h_i2c_mock.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
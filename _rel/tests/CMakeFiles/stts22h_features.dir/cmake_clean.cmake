@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/stts22h_features.dir/__/sources/stts22h.c.o"
+  "CMakeFiles/stts22h_features.dir/__/sources/stts22h.c.o.d"
+  "CMakeFiles/stts22h_features.dir/__/sources/stts22h_bus.c.o"
+  "CMakeFiles/stts22h_features.dir/__/sources/stts22h_bus.c.o.d"
+  "CMakeFiles/stts22h_features.dir/__/sources/stts22h_fifo.c.o"
+  "CMakeFiles/stts22h_features.dir/__/sources/stts22h_fifo.c.o.d"
+  "CMakeFiles/stts22h_features.dir/__/sources/stts22h_filter.c.o"
+  "CMakeFiles/stts22h_features.dir/__/sources/stts22h_filter.c.o.d"
+  "CMakeFiles/stts22h_features.dir/__/sources/stts22h_log.c.o"
+  "CMakeFiles/stts22h_features.dir/__/sources/stts22h_log.c.o.d"
+  "libstts22h_features.a"
+  "libstts22h_features.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/stts22h_features.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/stts22h_features_test.c" "tests/CMakeFiles/stts22h_features_test.dir/stts22h_features_test.c.o" "gcc" "tests/CMakeFiles/stts22h_features_test.dir/stts22h_features_test.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel/tests/CMakeFiles/stts22h_features.dir/DependInfo.cmake"
+  "/root/repo/_rel/CMakeFiles/stts22h_i2c_mock.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/stts22h_test.dir/stts22h_test.c.o"
+  "CMakeFiles/stts22h_test.dir/stts22h_test.c.o.d"
+  "stts22h_test"
+  "stts22h_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/stts22h_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
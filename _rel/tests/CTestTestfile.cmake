@@ -0,0 +1,14 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/_rel/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(stts22h_bench "/root/repo/_rel/tests/stts22h_bench")
+set_tests_properties(stts22h_bench PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;3;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(stts22h_test "/root/repo/_rel/tests/stts22h_test")
+set_tests_properties(stts22h_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;7;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(stts22h_linux_test "/root/repo/_rel/tests/stts22h_linux_test")
+set_tests_properties(stts22h_linux_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(stts22h_features_test "/root/repo/_rel/tests/stts22h_features_test")
+set_tests_properties(stts22h_features_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;33;add_test;/root/repo/tests/CMakeLists.txt;0;")
@@ -1,257 +1,1834 @@
+#include <string.h>
+
 #include "stts22h.h"
 
-static const uint8_t WHOAMI = 0xA0;
+#if STTS22H_USE_FIFO
+#include "stts22h_fifo.h"
+#endif
+#if STTS22H_USE_FILTER
+#include "stts22h_filter.h"
+#endif
+#if STTS22H_USE_LOG
+#include "stts22h_log.h"
+#endif
+
+static const uint8_t WHOAMI = 0xA0;
+
+// number of the register values of the readings
+enum STTS22H_ReadSizes {
+    WHOAMI_READ_SIZE = 1,
+    STATUS_READ_SIZE = 3, // STATUS, TEMP_L_OUT, TEMP_H_OUT
+    TEMP_READ_SIZE = 2, // TEMP_L_OUT, TEMP_H_OUT
+};
+
+// the build is failed, if the data structure exceeds the memory budget (the bus budgets are checked by the test)
+_Static_assert(sizeof(((STTS22H_Def *) NULL)->rxData) >= STATUS_READ_SIZE, "rxData is less than the reading");
+_Static_assert(sizeof(STTS22H_Def) <= STTS22H_BUDGET_DATA_SIZE, "STTS22H_Def exceeds the memory budget");
+
+enum STTS22H_OneShotSteps {
+    ONE_SHOT_WAIT = 0, // waiting for the next period
+    ONE_SHOT_TRIGGER, // the "one_shot" bit is being written
+    ONE_SHOT_CONVERSION, // waiting for the end of the conversion
+    ONE_SHOT_READ, // the status and temperature registers are being read
+};
+
+enum STTS22H_StreamingSteps {
+    STREAM_SETUP = 0, // freerun mode should be turned ON
+    STREAM_CONFIG, // the control register is being written
+    STREAM_WAIT, // waiting for the next output data
+    STREAM_READ, // the temperature registers are being read
+};
+
+// the conversion lasts one output data period of the selected averaging (STTS22H_AVG values), us
+// the same values are the freerun mode output data periods
+static const uint32_t CONVERSION_TIME[] = {40000, 20000, 10000, 5000};
+// the output data periods of the streaming (STTS22H_Rates values), us
+static const uint32_t RATE_PERIOD[] = {1000000, 40000, 20000, 10000, 5000};
+static const uint32_t BUSY_RETRY_TIME = 1000; // us
+
+enum STTS22H_ShadowRegisters {
+    SHADOW_H_LIMIT = 0, // STTS22H_TEMP_H_LIMIT_ADDR
+    SHADOW_L_LIMIT, // STTS22H_TEMP_L_LIMIT_ADDR
+    SHADOW_CTRL, // STTS22H_CTRL_ADDR
+    SHADOW_NUMBER
+};
+
+#if STTS22H_USE_I2C_DRIVER
+
+/**
+ * @brief Write data by the I2C interface (default transport)
+ * @param i2c is the base I2C interface data structure
+ * @param devAddr is the device address
+ * @param data is the data
+ * @param dataSize is the number of bytes
+ * @param isBlocking is a flag (True - wait for the end of the transfer)
+ * @return I2C_Errors values
+ */
+static int i2cWrite(I2CDef *i2c, uint8_t devAddr, const uint8_t *data, uint8_t dataSize, bool isBlocking) {
+    return I2C_writeData(i2c, devAddr, data, dataSize, isBlocking);
+}
+
+/**
+ * @brief Start reading by the I2C interface (default transport)
+ * @param i2c is the base I2C interface data structure
+ * @param devAddr is the device address
+ * @param regAddr is the first register address (it isn't used)
+ * @param dataSize is the number of bytes
+ * @return I2C_Errors values
+ */
+static int i2cRead(I2CDef *i2c, uint8_t devAddr, uint8_t regAddr, uint8_t dataSize) {
+    (void) regAddr;
+    return I2C_readData(i2c, devAddr, dataSize);
+}
+
+/**
+ * @brief Get the received data of the I2C interface (default transport)
+ * @param i2c is the base I2C interface data structure
+ * @return pointer to the received data
+ */
+static const uint8_t *i2cGetReceivedData(I2CDef *i2c) {
+    return (const uint8_t *) I2C_getReceivedData(i2c);
+}
+
+/**
+ * @brief Check, that the I2C interface has an active transfer (default transport)
+ * @param i2c is the base I2C interface data structure
+ * @return True - the transfer is in progress, otherwise - False
+ */
+static bool i2cIsBusy(I2CDef *i2c) {
+    return I2C_isReading(i2c) || I2C_isWriting(i2c);
+}
+
+/**
+ * @brief Check, that the last transfer of the I2C interface has been failed (default transport)
+ * @param i2c is the base I2C interface data structure
+ * @return True - the transfer has been failed, otherwise - False
+ */
+static bool i2cIsFailed(I2CDef *i2c) {
+    return I2C_isFailed(i2c);
+}
+
+const STTS22H_Transport_Def STTS22H_I2C_TRANSPORT = {
+        .write = i2cWrite,
+        .read = i2cRead,
+        .getReceivedData = i2cGetReceivedData,
+        .isBusy = i2cIsBusy,
+        .isFailed = i2cIsFailed,
+        .writeRead = NULL,
+        .readInto = NULL
+};
+
+#endif // STTS22H_USE_I2C_DRIVER
+
+/**
+ * @brief Check, that the temperature sensor is initialized
+ * @param stts is the STTS22H data structure
+ * @return True - sensor has been initialized, otherwise - False
+ */
+static bool isInit(const STTS22H_Def *stts) {
+#if STTS22H_USE_I2C_DRIVER
+    return stts->isInit;
+#else
+    return stts->isInit && stts->transport != NULL; // the platform transport has been set
+#endif
+}
+
+/**
+ * @brief Check, that the temperature sensor is reading or writing register values
+ * @param stts is the STTS22H data structure
+ * @return True - the transaction is in progress, otherwise - False
+ */
+static bool isBusy(const STTS22H_Def *stts) {
+    return stts->phase != STTS22H_PHASE_IDLE;
+}
+
+/**
+ * @brief Check, that the required time has come
+ * @param now is current time (us)
+ * @param time is the required time (us)
+ * @return True - the time has come, otherwise - False
+ */
+static bool isTimeReached(uint32_t now, uint32_t time) {
+    return (int32_t) (now - time) >= 0;
+}
+
+#if STTS22H_USE_STATS
+
+/**
+ * @brief Count the start of the transaction
+ * @param stts is the STTS22H data structure
+ */
+static void statsStart(STTS22H_Def *stts) {
+    stts->stats.started++;
+    if (stts->getTime != NULL)
+        stts->transferTime = stts->getTime();
+}
+
+/**
+ * @brief Count the end of the transaction
+ * @param stts is the STTS22H data structure
+ * @param isFailed is a flag (True - the transfer has been failed)
+ * @param size is the number of the transferred bytes (device address isn't counted)
+ */
+static void statsFinish(STTS22H_Def *stts, bool isFailed, uint8_t size) {
+    STTS22H_Stats_Def *stats = &stts->stats;
+    if (isFailed) {
+        stats->failed++;
+        return;
+    }
+
+    stats->completed++;
+    stats->bytes += size;
+    if (stts->getTime != NULL) {
+        uint32_t latency = stts->getTime() - stts->transferTime;
+        if (stats->completed == 1 || latency < stats->minLatency)
+            stats->minLatency = latency;
+        if (latency > stats->maxLatency)
+            stats->maxLatency = latency;
+        stats->totalLatency += latency;
+    }
+}
+
+#else
+
+#define statsStart(stts) ((void) (stts))
+#define statsFinish(stts, isFailed, size) ((void) (stts))
+
+#endif // STTS22H_USE_STATS
+
+/**
+ * @brief Reject the request, because the previous transaction hasn't been finished
+ * @param stts is the STTS22H data structure
+ * @return STTS22H_BUSY
+ */
+static int rejectBusy(STTS22H_Def *stts) {
+#if STTS22H_USE_STATS
+    stts->stats.rejected++;
+#else
+    (void) stts;
+#endif
+    return STTS22H_BUSY;
+}
+
+/**
+ * @brief Get current time for the connection recovery
+ * @param stts is the STTS22H data structure
+ * @return current time (us, 0 - there is no time source)
+ */
+static uint32_t getNow(const STTS22H_Def *stts) {
+    return (stts->getTime != NULL) ? stts->getTime() : 0;
+}
+
+/**
+ * @brief Get the interval of the connection check (it is doubled by every failed check up to the maximum)
+ * @param retries is the number of the failed connection checks
+ * @return interval (us)
+ */
+static uint32_t getBackoff(uint8_t retries) {
+    uint32_t backoff = STTS22H_RECONNECT_MIN_TIME;
+    for (uint8_t i = 0; i < retries && backoff < STTS22H_RECONNECT_MAX_TIME; ++i)
+        backoff = (backoff < STTS22H_RECONNECT_MAX_TIME / 2) ? backoff * 2 : STTS22H_RECONNECT_MAX_TIME;
+    return backoff;
+}
+
+/**
+ * @brief Update the connection health after the end of the transaction
+ * @param stts is the STTS22H data structure
+ * @param isFailed is a flag (True - the transaction has been failed)
+ */
+static void processHealth(STTS22H_Def *stts, bool isFailed) {
+    if (!isFailed) {
+        stts->failures = 0;
+        if (stts->isDegraded) {
+            // the sensor could be restarted, so the known configuration is written again
+            stts->isDegraded = false;
+            stts->dirty |= stts->cached;
+            stts->cached = 0;
+            stts->isAutoIncrement = false;
+        }
+        return;
+    }
+
+    if (stts->failures < UINT8_MAX)
+        stts->failures++;
+
+    if (stts->isDegraded) {
+        if (stts->retries < UINT8_MAX)
+            stts->retries++;
+        stts->retryTime = getNow(stts) + getBackoff(stts->retries);
+    } else if (stts->failures >= STTS22H_MAX_FAILURES) {
+        stts->isDegraded = true;
+        stts->isConnected = false;
+        stts->retries = 0;
+        stts->retryTime = getNow(stts) + getBackoff(stts->retries);
+    }
+}
+
+#if STTS22H_USE_OS
+
+/**
+ * @brief Take the right to start a transaction (the check and the start of the transaction are atomic)
+ * @param stts is the STTS22H data structure
+ * @return True - the transaction can be started, otherwise - False
+ */
+static bool enter(STTS22H_Def *stts) {
+    if (atomic_flag_test_and_set_explicit(&stts->lock, memory_order_acquire))
+        return false;
+    if (isBusy(stts)) {
+        atomic_flag_clear_explicit(&stts->lock, memory_order_release);
+        return false;
+    }
+    if (stts->os != NULL && stts->os->lockBus != NULL && !stts->os->lockBus(stts->i2c)) {
+        atomic_flag_clear_explicit(&stts->lock, memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Give back the right to start a transaction
+ * @param stts is the STTS22H data structure
+ */
+static void leave(STTS22H_Def *stts) {
+    atomic_flag_clear_explicit(&stts->lock, memory_order_release);
+}
+
+/**
+ * @brief The transaction has been finished: the bus is released, the waiting task is notified
+ * @param stts is the STTS22H data structure
+ */
+static void finishTransaction(STTS22H_Def *stts) {
+    if (stts->os == NULL)
+        return;
+
+    if (stts->os->unlockBus != NULL)
+        stts->os->unlockBus(stts->i2c);
+
+    void *waiter = stts->waiter;
+    stts->waiter = NULL;
+    if (waiter != NULL && stts->os->notify != NULL)
+        stts->os->notify(waiter);
+}
+
+#else
+
+#define enter(stts) (!isBusy(stts))
+#define leave(stts) ((void) (stts))
+#define finishTransaction(stts) ((void) (stts))
+
+#endif // STTS22H_USE_OS
+
+/**
+ * @brief Start reading of the register values, the right to start the transaction has been taken (enter)
+ * @param stts is the STTS22H data structure
+ * @param regAddr is the first register address
+ * @param dataSize is the number of bytes that should be read
+ * @return STTS22H_Errors values
+ */
+static int beginReading(STTS22H_Def *stts, uint8_t regAddr, uint8_t dataSize) {
+    // the state is changed before the transfer, it can be finished by the interrupt at once
+    stts->regAddr = regAddr;
+    stts->dataSize = dataSize;
+    stts->result = STTS22H_BUSY;
+    const STTS22H_Transport_Def *transport = stts->transport;
+    stts->isZeroCopy = (transport->writeRead != NULL);
+    stts->phase = (transport->writeRead != NULL) ? STTS22H_PHASE_READ : STTS22H_PHASE_ADDRESS;
+    statsStart(stts);
+
+    int result;
+    if (transport->writeRead != NULL)
+        result = transport->writeRead(stts->i2c, stts->devAddr, &stts->regAddr, stts->rxData, stts->dataSize);
+    else
+        result = transport->write(stts->i2c, stts->devAddr, &stts->regAddr, sizeof(uint8_t), false);
+
+    if (result != I2C_SUCCESS) {
+        statsFinish(stts, true, 0);
+        stts->phase = STTS22H_PHASE_IDLE;
+        stts->result = (int16_t) result;
+#if STTS22H_USE_OS
+        stts->waiter = NULL; // the error is returned, the task isn't notified
+#endif
+        finishTransaction(stts);
+    }
+
+    leave(stts);
+    return result;
+}
+
+/**
+ * @brief Start reading of the register values (the register address is sent first)
+ * @param stts is the STTS22H data structure
+ * @param regAddr is the first register address
+ * @param dataSize is the number of bytes that should be read
+ * @return STTS22H_Errors values
+ */
+static int startReading(STTS22H_Def *stts, uint8_t regAddr, uint8_t dataSize) {
+    if (!enter(stts))
+        return rejectBusy(stts);
+
+    return beginReading(stts, regAddr, dataSize);
+}
+
+/**
+ * @brief The temperature sensor initialization
+ * @param stts is the STTS22H data structure
+ * @param i2c is the base I2C interface data structure
+ * @param addr is the device address (on I2C bus)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_init(STTS22H_Def *stts, I2CDef *i2c, uint8_t addr) {
+    if (stts == NULL || i2c == NULL || addr == 0)
+        return STTS22H_WRONG_DATA;
+
+    // callbacks, attachments, modes and states of the previous usage are removed
+    memset(stts, 0, sizeof(STTS22H_Def));
+    stts->i2c = i2c;
+#if STTS22H_USE_I2C_DRIVER
+    stts->transport = &STTS22H_I2C_TRANSPORT;
+#endif
+    stts->devAddr = addr;
+    stts->temp = -27315;
+    stts->result = STTS22H_SUCCESS;
+#if STTS22H_USE_OS
+    atomic_flag_clear(&stts->lock);
+#endif
+    stts->isInit = true;
+    return STTS22H_SUCCESS;
+}
+
+#if STTS22H_POOL_SIZE > 0
+
+static STTS22H_Def pool[STTS22H_POOL_SIZE]; // the instances are placed one by one (RAM size is known at link time)
+static uint8_t poolUsed = 0;
+
+/**
+ * @brief Take the initialized instance from the static pool (it should be called during the system initialization)
+ * @param i2c is the base I2C interface data structure
+ * @param addr is the device address
+ * @return the STTS22H data structure (NULL - the pool is empty or the wrong data)
+ */
+STTS22H_Def *STTS22H_alloc(I2CDef *i2c, uint8_t addr) {
+    if (poolUsed >= STTS22H_POOL_SIZE)
+        return NULL;
+
+    STTS22H_Def *stts = &pool[poolUsed];
+    if (STTS22H_init(stts, i2c, addr) != STTS22H_SUCCESS)
+        return NULL;
+
+    poolUsed++;
+    return stts;
+}
+
+#endif // STTS22H_POOL_SIZE
+
+/**
+ * @brief Set the transfer primitives of the platform
+ * @param stts is the STTS22H data structure
+ * @param transport is the transport functions, they should exist while they are used (NULL - STTS22H_I2C_TRANSPORT)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_setTransport(STTS22H_Def *stts, const STTS22H_Transport_Def *transport) {
+#if STTS22H_USE_I2C_DRIVER
+    if (transport == NULL)
+        transport = &STTS22H_I2C_TRANSPORT;
+#endif
+    if (transport == NULL || transport->write == NULL || transport->isBusy == NULL || transport->isFailed == NULL ||
+        (transport->readInto == NULL && (transport->read == NULL || transport->getReceivedData == NULL)))
+        return STTS22H_WRONG_DATA;
+    if (isBusy(stts))
+        return STTS22H_BUSY;
+
+    stts->transport = transport;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Read the value of the "WHOAMI" register to check the connection between MCU and the temperature sensor
+ * @param stts is the STTS22H data structure
+ * @return STTS22H_Errors values
+ */
+int STTS22H_checkConnection(STTS22H_Def *stts) {
+    if (!isInit(stts))
+        return STTS22H_NOT_INIT;
+    if (isBusy(stts))
+        return rejectBusy(stts);
+
+    return startReading(stts, STTS22H_WHOAMI_ADDR, WHOAMI_READ_SIZE);
+}
+
+/**
+ * @brief Check, that the temperature sensor is connected to MCU (I2C interface)
+ * @param stts is the STTS22H data structure
+ * @return True - there is a connection between MCU and the sensor, otherwise - False
+ */
+bool STTS22H_isConnected(const STTS22H_Def *stts) {
+    return stts->isConnected;
+}
+
+/**
+ * @brief Check, that the temperature sensor has an unfinished transaction
+ * @param stts is the STTS22H data structure
+ * @return True - the transaction is in progress, otherwise - False
+ */
+bool STTS22H_isBusy(const STTS22H_Def *stts) {
+    return isBusy(stts);
+}
+
+#if STTS22H_USE_STATS
+
+/**
+ * @brief Get the transactions statistics (it can be called during the sampling)
+ * @param stts is the STTS22H data structure
+ * @param stats is the output statistics
+ */
+void STTS22H_getStats(const STTS22H_Def *stts, STTS22H_Stats_Def *stats) {
+    *stats = stts->stats;
+}
+
+/**
+ * @brief Reset the transactions statistics
+ * @param stts is the STTS22H data structure
+ */
+void STTS22H_resetStats(STTS22H_Def *stts) {
+    stts->stats = (STTS22H_Stats_Def) {0};
+}
+
+#endif // STTS22H_USE_STATS
+
+/**
+ * @brief Get the result of the last asynchronous transaction
+ * @param stts is the STTS22H data structure
+ * @return STTS22H_Errors values (STTS22H_BUSY - the transaction is in progress)
+ */
+int STTS22H_getResult(const STTS22H_Def *stts) {
+    return stts->result;
+}
+
+/**
+ * @brief Get the result of the last write of the control and threshold registers
+ * (it isn't overwritten by the measurement transactions, that are started by STTS22H_update)
+ * @param stts is the STTS22H data structure
+ * @return STTS22H_Errors values (STTS22H_BUSY - the registers are being written)
+ */
+int STTS22H_getSettingResult(const STTS22H_Def *stts) {
+    return stts->settingResult;
+}
+
+/**
+ * @brief Get the shadow copy of the sensor register
+ * @param stts is the STTS22H data structure
+ * @param index is the STTS22H_ShadowRegisters value
+ * @return pointer to the shadow copy
+ */
+static uint8_t *getShadow(STTS22H_Def *stts, uint8_t index) {
+    return (index == SHADOW_CTRL) ? &stts->settings.full : &stts->limits[index];
+}
+
+/**
+ * @brief Change the shadow copy of the sensor register (the write is skipped, if the sensor has the same value)
+ * @param stts is the STTS22H data structure
+ * @param index is the STTS22H_ShadowRegisters value
+ * @param value is the new register value
+ */
+static void stageRegister(STTS22H_Def *stts, uint8_t index, uint8_t value) {
+    uint8_t *shadow = getShadow(stts, index);
+    if ((stts->cached & (1U << index)) && *shadow == value)
+        return;
+
+    *shadow = value;
+    stts->dirty |= (uint8_t) (1U << index);
+}
+
+/**
+ * @brief Prepare the transaction of all changed shadow copies (the automatic address increment is used)
+ * @param stts is the STTS22H data structure
+ * @return number of bytes, that should be written (0 - there are no changes)
+ */
+static uint8_t prepareRegisters(STTS22H_Def *stts) {
+    if (stts->dirty == 0)
+        return 0;
+
+    uint8_t first = 0;
+    while (!(stts->dirty & (1U << first)))
+        first++;
+    uint8_t last = SHADOW_NUMBER - 1;
+    while (!(stts->dirty & (1U << last)))
+        last--;
+
+    // the burst requires the automatic address increment (it is OFF after reset),
+    // otherwise every register is written separately, CTRL is the first (it can turn ON the increment)
+    if (!stts->isAutoIncrement) {
+        if (stts->dirty & (1U << SHADOW_CTRL))
+            first = SHADOW_CTRL;
+        last = first;
+    }
+
+    uint8_t size = 0;
+    stts->txData[size++] = STTS22H_TEMP_H_LIMIT_ADDR + first;
+    for (uint8_t i = first; i <= last; ++i)
+        stts->txData[size++] = *getShadow(stts, i);
+
+    stts->regAddr = stts->txData[0];
+    stts->written = (uint8_t) (((1U << (last + 1)) - 1) & ~((1U << first) - 1));
+    return size;
+}
+
+/**
+ * @brief Mark the written shadow copies as equal to the sensor registers
+ * @param stts is the STTS22H data structure
+ */
+static void completeRegisters(STTS22H_Def *stts) {
+    stts->cached |= stts->written;
+    if (stts->written & (1U << SHADOW_CTRL)) {
+        STTS22H_Control_Def control = {.full = stts->txData[SHADOW_CTRL + STTS22H_TEMP_H_LIMIT_ADDR - stts->regAddr + 1]};
+        stts->isAutoIncrement = control.fields.if_add_inc;
+    }
+    // the shadow copies could be changed during the asynchronous transaction
+    for (uint8_t i = 0; i < SHADOW_NUMBER; ++i) {
+        if ((stts->written & (1U << i)) && *getShadow(stts, i) == stts->txData[i + STTS22H_TEMP_H_LIMIT_ADDR - stts->regAddr + 1])
+            stts->dirty &= (uint8_t) ~(1U << i);
+    }
+
+    // "one_shot" bit is reset automatically, so the same setting must be written again
+    if ((stts->written & (1U << SHADOW_CTRL)) && stts->settings.fields.one_shot) {
+        stts->settings.fields.one_shot = 0;
+        stts->cached &= (uint8_t) ~(1U << SHADOW_CTRL);
+    }
+    stts->written = 0;
+}
+
+/**
+ * @brief Write all changed shadow copies by one blocking transaction
+ * @param stts is the STTS22H data structure
+ * @return STTS22H_Errors values
+ */
+static int flushRegisters(STTS22H_Def *stts) {
+    if (stts->dirty == 0)
+        return STTS22H_SUCCESS;
+    if (!enter(stts))
+        return rejectBusy(stts);
+
+    // several transactions, if the registers can't be written by one burst
+    int result = I2C_SUCCESS;
+    while (stts->dirty != 0 && result == I2C_SUCCESS) {
+        uint8_t size = prepareRegisters(stts);
+        statsStart(stts);
+        result = stts->transport->write(stts->i2c, stts->devAddr, stts->txData, size, true);
+        statsFinish(stts, result != I2C_SUCCESS, size);
+        processHealth(stts, result != I2C_SUCCESS);
+        if (result == I2C_SUCCESS)
+            completeRegisters(stts);
+        else
+            stts->written = 0;
+    }
+
+    stts->settingResult = (int16_t) result;
+    finishTransaction(stts);
+    leave(stts);
+    return result;
+}
+
+/**
+ * @brief Start the asynchronous transaction of all changed shadow copies, it is finished by STTS22H_update
+ * @param stts is the STTS22H data structure
+ * @return STTS22H_Errors values
+ */
+static int startRegisters(STTS22H_Def *stts) {
+    if (stts->dirty == 0) {
+        stts->result = STTS22H_SUCCESS;
+        stts->settingResult = STTS22H_SUCCESS;
+        return STTS22H_SUCCESS;
+    }
+    if (!enter(stts))
+        return rejectBusy(stts);
+
+    uint8_t size = prepareRegisters(stts);
+    stts->dataSize = size;
+    stts->result = STTS22H_BUSY;
+    stts->settingResult = STTS22H_BUSY;
+    stts->phase = STTS22H_PHASE_WRITE;
+    statsStart(stts);
+
+    int result = stts->transport->write(stts->i2c, stts->devAddr, stts->txData, size, false);
+    if (result != I2C_SUCCESS) {
+        statsFinish(stts, true, 0);
+        stts->phase = STTS22H_PHASE_IDLE;
+        stts->written = 0;
+        stts->result = (int16_t) result;
+        stts->settingResult = (int16_t) result;
+        finishTransaction(stts);
+    }
+
+    leave(stts);
+    return result;
+}
+
+/**
+ * @brief The temperature sensor setting (the write is skipped, if the sensor has the same value)
+ * @param stts is the STTS22H data structure
+ * @param controlReg is the control register value (STTS22H_ControlReg_Def.full)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_setting(STTS22H_Def *stts, uint8_t controlReg) {
+    if (!isInit(stts))
+        return STTS22H_NOT_INIT;
+    if (stts->isDegraded)
+        return STTS22H_NOT_CONNECTED;
+
+    if (isBusy(stts))
+        return rejectBusy(stts);
+
+    stageRegister(stts, SHADOW_CTRL, controlReg);
+    return flushRegisters(stts);
+}
+
+/**
+ * @brief The temperature sensor setting without waiting (the transaction is finished by STTS22H_update)
+ * @param stts is the STTS22H data structure
+ * @param controlReg is the control register value (STTS22H_ControlReg_Def.full)
+ * @return STTS22H_Errors values (the transaction result - STTS22H_getSettingResult)
+ */
+int STTS22H_settingAsync(STTS22H_Def *stts, uint8_t controlReg) {
+    if (!isInit(stts))
+        return STTS22H_NOT_INIT;
+    if (stts->isDegraded)
+        return STTS22H_NOT_CONNECTED;
+    if (isBusy(stts))
+        return rejectBusy(stts);
+
+    stageRegister(stts, SHADOW_CTRL, controlReg);
+    return startRegisters(stts);
+}
+
+/**
+ * @brief Convert temperature threshold to uint8_t value
+ * @param value is the required value (0.01 degrees Celsius, > -40.32C)
+ * @return valid register value (TEMP_H_LIMIT or TEMP_L_LIMIT)
+ */
+static uint8_t calculateThreshold(int16_t value) {
+    // Datasheet, DS12606, Rev7, Aug 2022, page 14
+    // value / 0.64 + 63, the result is truncated (the sum is always positive)
+
+    return (uint8_t) (((int32_t) value + 63 * 64) / 64);
+}
+
+/**
+ * @brief Change the shadow copies of the threshold registers
+ * @param stts is the STTS22H data structure
+ * @param minTemp is the required low threshold value (0.01 degrees Celsius)
+ * @param maxTemp is the required high threshold value (0.01 degrees Celsius)
+ * @param isSetLimits is a flag (True - set new levels, False - turn OFF interrupts)
+ */
+static void stageLimits(STTS22H_Def *stts, int16_t minTemp, int16_t maxTemp, bool isSetLimits) {
+    stageRegister(stts, SHADOW_H_LIMIT, isSetLimits ? calculateThreshold(maxTemp) : 0);
+    stageRegister(stts, SHADOW_L_LIMIT, isSetLimits ? calculateThreshold(minTemp) : 0);
+}
+
+/**
+ * @brief Turn ON/OFF two interrupt thresholds (the write is skipped, if the sensor has the same values)
+ * @param stts is the STTS22H data structure
+ * @param minTemp is the required low threshold value (0.01 degrees Celsius, > -39.5C)
+ * @param maxTemp is the required high threshold value (0.01 degrees Celsius, < +122.5C)
+ * @param isSetLimits is a flag (True - set new levels and turn ON interrupts, False - turn OFF interrupts)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_setLimits_cC(STTS22H_Def *stts, int16_t minTemp, int16_t maxTemp, bool isSetLimits) {
+    if (!isInit(stts))
+        return STTS22H_NOT_INIT;
+
+    // Datasheet, DS12606, Rev7, Aug 2022, page 18
+    if (minTemp < -3950 || maxTemp > 12250)
+        return STTS22H_WRONG_DATA;
+
+    if (stts->isDegraded)
+        return STTS22H_NOT_CONNECTED;
+    if (isBusy(stts))
+        return rejectBusy(stts);
+
+    stageLimits(stts, minTemp, maxTemp, isSetLimits);
+    return flushRegisters(stts);
+}
+
+/**
+ * @brief Turn ON/OFF two interrupt thresholds without waiting (the transaction is finished by STTS22H_update)
+ * @param stts is the STTS22H data structure
+ * @param minTemp is the required low threshold value (0.01 degrees Celsius, > -39.5C)
+ * @param maxTemp is the required high threshold value (0.01 degrees Celsius, < +122.5C)
+ * @param isSetLimits is a flag (True - set new levels and turn ON interrupts, False - turn OFF interrupts)
+ * @return STTS22H_Errors values (the transaction result - STTS22H_getSettingResult)
+ */
+int STTS22H_setLimitsAsync_cC(STTS22H_Def *stts, int16_t minTemp, int16_t maxTemp, bool isSetLimits) {
+    if (!isInit(stts))
+        return STTS22H_NOT_INIT;
+
+    // Datasheet, DS12606, Rev7, Aug 2022, page 18
+    if (minTemp < -3950 || maxTemp > 12250)
+        return STTS22H_WRONG_DATA;
+    if (stts->isDegraded)
+        return STTS22H_NOT_CONNECTED;
+    if (isBusy(stts))
+        return rejectBusy(stts);
+
+    stageLimits(stts, minTemp, maxTemp, isSetLimits);
+    return startRegisters(stts);
+}
+
+/**
+ * @brief Write the control register and the thresholds without waiting
+ * (one burst, if IF_ADD_INC is set, otherwise CTRL is the first and the rest is written by STTS22H_update)
+ * @param stts is the STTS22H data structure
+ * @param controlReg is the control register value (STTS22H_ControlReg_Def.full)
+ * @param minTemp is the required low threshold value (0.01 degrees Celsius, > -39.5C)
+ * @param maxTemp is the required high threshold value (0.01 degrees Celsius, < +122.5C)
+ * @param isSetLimits is a flag (True - set new levels and turn ON interrupts, False - turn OFF interrupts)
+ * @return STTS22H_Errors values (the transaction result - STTS22H_getSettingResult)
+ */
+int STTS22H_configureAsync(STTS22H_Def *stts, uint8_t controlReg, int16_t minTemp, int16_t maxTemp, bool isSetLimits) {
+    if (!isInit(stts))
+        return STTS22H_NOT_INIT;
+    if (minTemp < -3950 || maxTemp > 12250)
+        return STTS22H_WRONG_DATA;
+    if (stts->isDegraded)
+        return STTS22H_NOT_CONNECTED;
+    if (isBusy(stts))
+        return rejectBusy(stts);
+
+    // TEMP_H_LIMIT, TEMP_L_LIMIT and CTRL are neighbours, the changed registers are written by one burst (IF_ADD_INC)
+    stageLimits(stts, minTemp, maxTemp, isSetLimits);
+    stageRegister(stts, SHADOW_CTRL, controlReg);
+    return startRegisters(stts);
+}
+
+/**
+ * @brief Forget the cached register values (e.g. after the sensor power cycle), the next writes are not skipped
+ * @param stts is the STTS22H data structure
+ */
+void STTS22H_invalidateCache(STTS22H_Def *stts) {
+    stts->cached = 0;
+    stts->isAutoIncrement = false;
+}
+
+#if STTS22H_USE_FLOAT
+
+/**
+ * @brief Turn ON/OFF two interrupt thresholds
+ * @param stts is the STTS22H data structure
+ * @param minTemp is the required low threshold value (degrees Celsius, > -39.5C)
+ * @param maxTemp is the required high threshold value (degrees Celsius, < +122.5C)
+ * @param isSetLimits is a flag (True - set new levels and turn ON interrupts, False - turn OFF interrupts)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_setLimits(STTS22H_Def *stts, float minTemp, float maxTemp, bool isSetLimits) {
+    // Datasheet, DS12606, Rev7, Aug 2022, page 18
+    if (minTemp < -39.5f || maxTemp > 122.5f)
+        return STTS22H_WRONG_DATA;
+
+    return STTS22H_setLimits_cC(stts, (int16_t) (minTemp * 100.0f), (int16_t) (maxTemp * 100.0f), isSetLimits);
+}
+
+/**
+ * @brief Turn ON/OFF two interrupt thresholds without waiting (the transaction is finished by STTS22H_update)
+ * @param stts is the STTS22H data structure
+ * @param minTemp is the required low threshold value (degrees Celsius, > -39.5C)
+ * @param maxTemp is the required high threshold value (degrees Celsius, < +122.5C)
+ * @param isSetLimits is a flag (True - set new levels and turn ON interrupts, False - turn OFF interrupts)
+ * @return STTS22H_Errors values (the transaction result - STTS22H_getSettingResult)
+ */
+int STTS22H_setLimitsAsync(STTS22H_Def *stts, float minTemp, float maxTemp, bool isSetLimits) {
+    // Datasheet, DS12606, Rev7, Aug 2022, page 18
+    if (minTemp < -39.5f || maxTemp > 122.5f)
+        return STTS22H_WRONG_DATA;
+
+    return STTS22H_setLimitsAsync_cC(stts, (int16_t) (minTemp * 100.0f), (int16_t) (maxTemp * 100.0f), isSetLimits);
+}
+
+#endif // STTS22H_USE_FLOAT
+
+/**
+ * @brief Read the status and temperature registers values
+ * @param stts is the STTS22H data structure
+ * @return STTS22H_Errors values
+ */
+int STTS22H_measure(STTS22H_Def *stts) {
+    if (!isInit(stts))
+        return STTS22H_NOT_INIT;
+    if (stts->isDegraded)
+        return STTS22H_NOT_CONNECTED;
+    if (isBusy(stts))
+        return rejectBusy(stts);
+
+    return startReading(stts, STTS22H_STATUS_ADDR, STATUS_READ_SIZE);
+}
+
+/**
+ * @brief Get the duration of the one-shot conversion (it depends on the averaging of the control register)
+ * @param stts is the STTS22H data structure
+ * @return conversion time (us)
+ */
+uint32_t STTS22H_getConversionTime(const STTS22H_Def *stts) {
+    return CONVERSION_TIME[stts->settings.fields.avg];
+}
+
+#if STTS22H_USE_OS
+
+/**
+ * @brief Set the OS abstraction layer (bus lock, task notification)
+ * @param stts is the STTS22H data structure
+ * @param os is the OS functions (NULL - turn OFF)
+ */
+void STTS22H_setOS(STTS22H_Def *stts, const STTS22H_OS_Def *os) {
+    stts->os = os;
+}
+
+/**
+ * @brief Read the status and temperature registers values and sleep until the end of the transaction
+ * (STTS22H_update or STTS22H_transferComplete must be called by another task or interrupt)
+ * @param stts is the STTS22H data structure
+ * @param timeout is the maximum waiting time (OS layer units)
+ * @return STTS22H_Errors values (STTS22H_BUSY - timeout, the transaction is still in progress)
+ */
+int STTS22H_measureWait(STTS22H_Def *stts, uint32_t timeout) {
+    if (!isInit(stts))
+        return STTS22H_NOT_INIT;
+    if (stts->os == NULL || stts->os->getTask == NULL || stts->os->wait == NULL)
+        return STTS22H_WRONG_DATA;
+
+    if (stts->isDegraded)
+        return STTS22H_NOT_CONNECTED;
+    if (!enter(stts))
+        return rejectBusy(stts);
+
+    // the waiter is set by the owner of the transaction before the start (it could be finished at once),
+    // the rejected task doesn't touch the waiter of the active transaction
+    void *task = stts->os->getTask();
+    stts->waiter = task;
+    int result = beginReading(stts, STTS22H_STATUS_ADDR, STATUS_READ_SIZE);
+    if (result != STTS22H_SUCCESS)
+        return result;
+
+    if (!stts->os->wait(timeout)) {
+        // the finished transaction has cleared the waiter, the next one could have another waiter
+        if (stts->waiter == task)
+            stts->waiter = NULL;
+        return STTS22H_BUSY;
+    }
+    return stts->result;
+}
+
+#endif // STTS22H_USE_OS
+
+/**
+ * @brief Convert the temperature value to Fahrenheit
+ * @param temp is the temperature value (0.01C)
+ * @return temperature value (0.01F)
+ */
+static int32_t toFahrenheit(int32_t temp) {
+    return 3200 + temp * 9 / 5;
+}
+
+/**
+ * @brief Convert the temperature value to Kelvin
+ * @param temp is the temperature value (0.01C)
+ * @return temperature value (0.01K)
+ */
+static int32_t toKelvin(int32_t temp) {
+    return temp + 27315;
+}
+
+#if STTS22H_USE_FLOAT
+
+/**
+ * @brief Convert the temperature value to the float value
+ * @param temp is the temperature value (0.01C)
+ * @return temperature value (C)
+ */
+static float toCelsiusFloat(int16_t temp) {
+    return (float) temp / 100.0f;
+}
+
+/**
+ * @brief Convert the temperature value to the float value in Fahrenheit
+ * @param temp is the temperature value (0.01C)
+ * @return temperature value (F)
+ */
+static float toFahrenheitFloat(int16_t temp) {
+    float value = (float) temp / 100.0f;
+    value = 32.0f + value * 9.0f / 5.0f;
+    return value;
+}
+
+#endif // STTS22H_USE_FLOAT
+
+/**
+ * @brief Get the last measured temperature value (0.01C)
+ * @param stts is the STTS22H data structure
+ * @return temperature value (0.01 degrees Celsius)
+ */
+int16_t STTS22H_getTemp_cC(const STTS22H_Def *stts) {
+    return stts->temp;
+}
+
+/**
+ * @brief Get the last measured temperature value (0.01F)
+ * @param stts is the STTS22H data structure
+ * @return temperature value (0.01 degrees Fahrenheit)
+ */
+int32_t STTS22H_getTemp_cF(const STTS22H_Def *stts) {
+    return toFahrenheit(stts->temp);
+}
+
+/**
+ * @brief Convert the array of temperature values (e.g. the buffered samples)
+ * @param temp is the input values (0.01C)
+ * @param number is the number of values
+ * @param out is the output values (0.01 degrees of STTS22H_Units), it mustn't overlap the input values
+ * @param unit is STTS22H_Units value
+ * @return STTS22H_Errors values
+ */
+int STTS22H_convertBulk(const int16_t *restrict temp, size_t number, int32_t *restrict out, uint8_t unit) {
+    if ((temp == NULL || out == NULL) && number != 0)
+        return STTS22H_WRONG_DATA;
+
+    // the same expressions, as the single value functions, the loops are simple to be vectorized by the compiler
+    switch (unit) {
+        case STTS22H_CELSIUS:
+            for (size_t i = 0; i < number; ++i)
+                out[i] = temp[i];
+            break;
+        case STTS22H_FAHRENHEIT:
+            for (size_t i = 0; i < number; ++i)
+                out[i] = toFahrenheit(temp[i]);
+            break;
+        case STTS22H_KELVIN:
+            for (size_t i = 0; i < number; ++i)
+                out[i] = toKelvin(temp[i]);
+            break;
+        default:
+            return STTS22H_WRONG_DATA;
+    }
+    return STTS22H_SUCCESS;
+}
+
+#if STTS22H_USE_FLOAT
+
+/**
+ * @brief Get the last measured temperature value (C)
+ * @param stts is the STTS22H data structure
+ * @return temperature value (degrees Celsius)
+ */
+float STTS22H_getTemp_C(const STTS22H_Def *stts) {
+    return toCelsiusFloat(stts->temp);
+}
+
+/**
+ * @brief Get the last measured temperature value (F)
+ * @param stts is the STTS22H data structure
+ * @return temperature value (degrees Fahrenheit)
+ */
+float STTS22H_getTemp_F(const STTS22H_Def *stts) {
+    return toFahrenheitFloat(stts->temp);
+}
+
+/**
+ * @brief Convert the array of temperature values (e.g. the buffered samples)
+ * @param temp is the input values (0.01C)
+ * @param number is the number of values
+ * @param out is the output values (degrees of STTS22H_Units), it mustn't overlap the input values
+ * @param unit is STTS22H_Units value
+ * @return STTS22H_Errors values
+ */
+int STTS22H_convertBulkFloat(const int16_t *restrict temp, size_t number, float *restrict out, uint8_t unit) {
+    if ((temp == NULL || out == NULL) && number != 0)
+        return STTS22H_WRONG_DATA;
+
+    switch (unit) {
+        case STTS22H_CELSIUS:
+            for (size_t i = 0; i < number; ++i)
+                out[i] = toCelsiusFloat(temp[i]);
+            break;
+        case STTS22H_FAHRENHEIT:
+            for (size_t i = 0; i < number; ++i)
+                out[i] = toFahrenheitFloat(temp[i]);
+            break;
+        case STTS22H_KELVIN:
+            for (size_t i = 0; i < number; ++i)
+                out[i] = toCelsiusFloat(temp[i]) + 273.15f;
+            break;
+        default:
+            return STTS22H_WRONG_DATA;
+    }
+    return STTS22H_SUCCESS;
+}
+
+#endif // STTS22H_USE_FLOAT
+
+/**
+ * @brief Take the last measured sample
+ * @param stts is the STTS22H data structure
+ * @param sample is the output sample
+ * @return True - the sample is new (it hasn't been taken before), otherwise - False
+ */
+bool STTS22H_getSample(STTS22H_Def *stts, STTS22H_Sample_Def *sample) {
+    bool isNew = stts->isNewSample;
+    stts->isNewSample = false;
+
+    sample->raw = stts->temp;
+    sample->status = stts->status;
+    sample->sequence = stts->sequence;
+    sample->timestamp = stts->timestamp;
+    return isNew;
+}
+
+/**
+ * @brief Get the number of the samples, that have been replaced before they were taken (STTS22H_getSample)
+ * @param stts is the STTS22H data structure
+ * @return number of samples
+ */
+uint32_t STTS22H_getOverruns(const STTS22H_Def *stts) {
+    return stts->overruns;
+}
+
+/**
+ * @brief Get the last measured values of several sensors
+ * @param stts is the array of the STTS22H data structures
+ * @param number is the number of sensors
+ * @param out is the output arrays (every array has "number" elements, NULL - the array isn't required)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_readBatch(const STTS22H_Def *const *stts, size_t number, STTS22H_Batch_Def *out) {
+    if (stts == NULL || out == NULL)
+        return STTS22H_WRONG_DATA;
+
+    for (size_t i = 0; i < number; ++i) {
+        if (stts[i] == NULL)
+            return STTS22H_WRONG_DATA;
+    }
 
-enum STTS22H_RegAddresses {
-    WHOAMI_ADDR = 0x01,
-    TEMP_H_LIMIT_ADDR,
-    TEMP_L_LIMIT_ADDR,
-    CTRL_ADDR,
-    STATUS_ADDR,
-    TEMP_L_OUT_ADDR,
-    TEMP_H_OUT_ADDR
-};
+    if (out->temp != NULL) {
+        for (size_t i = 0; i < number; ++i)
+            out->temp[i] = stts[i]->temp;
+    }
+    if (out->status != NULL) {
+        for (size_t i = 0; i < number; ++i)
+            out->status[i] = stts[i]->status.full;
+    }
+    if (out->sequence != NULL) {
+        for (size_t i = 0; i < number; ++i)
+            out->sequence[i] = stts[i]->sequence;
+    }
+
+    return STTS22H_SUCCESS;
+}
 
 /**
- * @brief Check, that the temperature sensor is initialized
+ * @brief Check, that the temperature sensor has detected a value that is higher than the high limit
+ * (the last STATUS reading, the temperature readings of the streaming clear it)
  * @param stts is the STTS22H data structure
- * @return True - sensor has been initialized, otherwise - False
+ * @return True - is overheated, otherwise - False
  */
-static bool isInit(const STTS22H_Def *stts) {
-    return stts->isInit;
+bool STTS22H_isOverheated(const STTS22H_Def *stts) {
+    return stts->status.fields.over_thh;
 }
 
 /**
- * @brief Check, that the temperature sensor is reading register values
+ * @brief Check, that the temperature sensor has detected a value that is lower than the low limit
+ * (the last STATUS reading, the temperature readings of the streaming clear it)
  * @param stts is the STTS22H data structure
- * @return True - is reading, otherwise - False
+ * @return True - is overcooled, otherwise - False
  */
-static bool isReading(const STTS22H_Def *stts) {
-    return stts->isReading;
+bool STTS22H_isOvercooled(const STTS22H_Def *stts) {
+    return stts->status.fields.under_thl;
 }
 
 /**
- * @brief The temperature sensor initialization
+ * @brief Set the callback, that is called when a new temperature value has been measured
  * @param stts is the STTS22H data structure
- * @param i2c is the base I2C interface data structure
- * @param addr is the device address (on I2C bus)
- * @return STTS22H_Errors values
+ * @param onSample is the callback function (NULL - turn OFF)
  */
-int STTS22H_init(STTS22H_Def *stts, I2CDef *i2c, uint8_t addr) {
-    if (stts == NULL || i2c == NULL || addr == 0)
-        return STTS22H_WRONG_DATA;
+void STTS22H_setSampleCallback(STTS22H_Def *stts, STTS22H_SampleCallback_Def onSample) {
+    stts->onSample = onSample;
+}
 
-    stts->i2c = i2c;
-    stts->devAddr = addr;
-    stts->temp = -273.15f;
-    stts->isInit = true;
-    return STTS22H_SUCCESS;
+#if STTS22H_USE_DEADBAND
+
+/**
+ * @brief Turn ON/OFF the change detection: the sample is significant, if it differs from the last significant value
+ * by more than the deadband, or the heartbeat interval has expired
+ * @param stts is the STTS22H data structure
+ * @param deadband is the minimum change (0.01C)
+ * @param heartbeat is the maximum interval between the significant samples (us, 0 - not used, it requires the time source)
+ * @param onSignificant is the callback of the significant samples (NULL - STTS22H_isSignificant is used)
+ * (deadband = 0 and heartbeat = 0 - turn OFF)
+ */
+void STTS22H_setDeadband(STTS22H_Def *stts, uint16_t deadband, uint32_t heartbeat,
+                         STTS22H_SampleCallback_Def onSignificant) {
+    stts->useDeadband = false;
+    stts->isSignificant = false;
+    stts->deadband = deadband;
+    stts->heartbeat = heartbeat;
+    stts->onSignificant = onSignificant;
+    stts->reported = stts->temp;
+    stts->reportTime = 0;
+    stts->useDeadband = (deadband != 0 || heartbeat != 0);
 }
 
 /**
- * @brief Read the value of the "WHOAMI" register to check the connection between MCU and the temperature sensor
+ * @brief Check, that the last sample is significant (change detection mode)
  * @param stts is the STTS22H data structure
- * @return STTS22H_Errors values
+ * @return True - the sample is significant, otherwise - False
  */
-int STTS22H_checkConnection(STTS22H_Def *stts) {
-    if (!isInit(stts))
-        return STTS22H_NOT_INIT;
-    if (isReading(stts))
-        return STTS22H_BUSY;
+bool STTS22H_isSignificant(const STTS22H_Def *stts) {
+    return stts->isSignificant;
+}
+
+/**
+ * @brief Clear the flag of the significant sample
+ * @param stts is the STTS22H data structure
+ */
+void STTS22H_clearSignificant(STTS22H_Def *stts) {
+    stts->isSignificant = false;
+}
 
-    stts->regAddr = WHOAMI_ADDR;
-    stts->dataSize = 1;
+/**
+ * @brief Check, that the new sample is significant (change detection mode)
+ * @param stts is the STTS22H data structure
+ */
+static void processDeadband(STTS22H_Def *stts) {
+    int32_t change = (int32_t) stts->temp - stts->reported;
+    if (change < 0)
+        change = -change;
 
-    int result = I2C_writeData(stts->i2c, stts->devAddr, &stts->regAddr, sizeof(uint8_t), false);
-    if (result == I2C_SUCCESS)
-        stts->isReading = true;
+    bool isSignificant = (change > stts->deadband);
+    if (stts->heartbeat != 0 && stts->getTime != NULL)
+        isSignificant |= isTimeReached(stts->timestamp, stts->reportTime + stts->heartbeat);
+    if (!isSignificant)
+        return;
 
-    return result;
+    stts->reported = stts->temp;
+    stts->reportTime = stts->timestamp;
+    stts->isSignificant = true;
+    if (stts->onSignificant != NULL)
+        stts->onSignificant(stts, stts->temp);
 }
 
+#if STTS22H_USE_FIFO
+
+#endif // STTS22H_USE_DEADBAND
+
 /**
- * @brief Check, that the temperature sensor is connected to MCU (I2C interface)
+ * @brief Attach the ring buffer, every new sample is stored to it
  * @param stts is the STTS22H data structure
- * @return True - there is a connection between MCU and the sensor, otherwise - False
+ * @param fifo is the initialized ring buffer (NULL - detach)
  */
-bool STTS22H_isConnected(const STTS22H_Def *stts) {
-    return stts->isConnected;
+void STTS22H_attachFifo(STTS22H_Def *stts, struct STTS22H_Fifo_Data *fifo) {
+    stts->fifo = fifo;
 }
 
+#endif // STTS22H_USE_FIFO
+
+#if STTS22H_USE_FILTER
+
 /**
- * @brief The temperature sensor setting
+ * @brief Attach the filter, every new sample is put into it
  * @param stts is the STTS22H data structure
- * @param controlReg is the control register value (STTS22H_ControlReg_Def.full)
- * @return STTS22H_Errors values
+ * @param filter is the initialized filter (NULL - detach)
+ * @param onFiltered is the callback of the filter output values (NULL - STTS22H_Filter_getOutput is used)
  */
-int STTS22H_setting(STTS22H_Def *stts, uint8_t controlReg) {
-    if (!isInit(stts))
-        return STTS22H_NOT_INIT;
+void STTS22H_attachFilter(STTS22H_Def *stts, struct STTS22H_Filter_Data *filter, STTS22H_SampleCallback_Def onFiltered) {
+    stts->filter = filter;
+    stts->onFiltered = onFiltered;
+}
 
-    uint8_t data[2] = {0};
-    data[0] = CTRL_ADDR;
-    data[1] = controlReg;
+#endif // STTS22H_USE_FILTER
 
-    int result = I2C_writeData(stts->i2c, stts->devAddr, data, 2, true);
-    if (result == I2C_SUCCESS)
-        stts->settings.full = controlReg;
+#if STTS22H_USE_LOG
 
-    return result;
+/**
+ * @brief Attach the log encoder, every new sample is written to its current page
+ * @param stts is the STTS22H data structure
+ * @param log is the initialized encoder (NULL - detach)
+ */
+void STTS22H_attachLog(STTS22H_Def *stts, struct STTS22H_LogEncoder_Data *log) {
+    stts->log = log;
 }
 
+#endif // STTS22H_USE_LOG
+
+#if STTS22H_USE_ALERT
+
 /**
- * @brief Convert temperature threshold (float) to uint8_t value
- * @param value is the required value (degrees Celsius)
- * @return valid register value (TEMP_H_LIMIT or TEMP_L_LIMIT)
+ * @brief Set the callbacks, that are called when the temperature thresholds have been exceeded
+ * @param stts is the STTS22H data structure
+ * @param onOverheat is the high limit callback (NULL - turn OFF)
+ * @param onOvercool is the low limit callback (NULL - turn OFF)
  */
-static uint8_t calculateThreshold(float value) {
-    // Datasheet, DS12606, Rev7, Aug 2022, page 14
+void STTS22H_setAlertCallbacks(STTS22H_Def *stts, STTS22H_SampleCallback_Def onOverheat,
+                               STTS22H_SampleCallback_Def onOvercool) {
+    stts->onOverheat = onOverheat;
+    stts->onOvercool = onOvercool;
+}
+
+/**
+ * @brief The ALERT/INT pin has been asserted (it should be called from the GPIO interrupt handler, falling edge),
+ * the status and temperature registers are read by the next STTS22H_update call
+ * @param stts is the STTS22H data structure
+ */
+void STTS22H_alertHandler(STTS22H_Def *stts) {
+    stts->alertPending = true;
+}
+
+#endif // STTS22H_USE_ALERT
 
-    value /= 0.64f;
-    value += 63.0f;
-    return (uint8_t) value;
+/**
+ * @brief Check, that the ALERT/INT event is waiting for the status reading
+ * @param stts is the STTS22H data structure
+ * @return True - the event is pending, otherwise - False
+ */
+bool STTS22H_isAlertPending(const STTS22H_Def *stts) {
+#if STTS22H_USE_ALERT
+    return stts->alertPending;
+#else
+    (void) stts;
+    return false;
+#endif
 }
 
 /**
- * @brief Turn ON/OFF two interrupt thresholds
+ * @brief Set the time source, that is used by the periodic modes
  * @param stts is the STTS22H data structure
- * @param minTemp is the required low threshold value (degrees Celsius, > -39.5C)
- * @param maxTemp is the required high threshold value (degrees Celsius, < +122.5C)
- * @param isSetLimits is a flag (True - set new levels and turn ON interrupts, False - turn OFF interrupts)
+ * @param getTime is the function, that returns current time (microseconds)
+ */
+void STTS22H_setTimeSource(STTS22H_Def *stts, STTS22H_GetTime_Def getTime) {
+    stts->getTime = getTime;
+}
+
+/**
+ * @brief Start periodic one-shot conversions, the sensor stays in power-down mode between them
+ * @param stts is the STTS22H data structure
+ * @param period is the conversions period (us, 0 - the single conversion)
  * @return STTS22H_Errors values
  */
-int STTS22H_setLimits(STTS22H_Def *stts, float minTemp, float maxTemp, bool isSetLimits) {
+int STTS22H_startOneShot(STTS22H_Def *stts, uint32_t period) {
     if (!isInit(stts))
         return STTS22H_NOT_INIT;
+    if (stts->getTime == NULL)
+        return STTS22H_WRONG_DATA;
 
-    // Datasheet, DS12606, Rev7, Aug 2022, page 18
-    if (minTemp < -39.5f || maxTemp > 122.5f)
+    stts->period = period;
+    stts->step = ONE_SHOT_WAIT;
+    stts->eventTime = stts->getTime();
+    stts->mode = STTS22H_MODE_ONE_SHOT;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Stop periodic one-shot conversions (the active transaction is finished)
+ * @param stts is the STTS22H data structure
+ */
+void STTS22H_stopOneShot(STTS22H_Def *stts) {
+    if (stts->mode == STTS22H_MODE_ONE_SHOT)
+        stts->mode = STTS22H_MODE_MANUAL;
+}
+
+/**
+ * @brief Move the one-shot conversion to the next step (there is no active transaction)
+ * @param stts is the STTS22H data structure
+ */
+static void processOneShot(STTS22H_Def *stts) {
+    uint32_t now = stts->getTime();
+
+    switch (stts->step) {
+        case ONE_SHOT_WAIT:
+            if (isTimeReached(now, stts->eventTime)) {
+                STTS22H_Control_Def control = stts->settings;
+                control.fields.freerun = 0; // power-down after the conversion
+                control.fields.low_odr_start = 0;
+                control.fields.one_shot = 1;
+
+                stageRegister(stts, SHADOW_CTRL, control.full);
+                if (startRegisters(stts) == STTS22H_SUCCESS) {
+                    stts->startTime = now;
+                    stts->step = ONE_SHOT_TRIGGER;
+                }
+            }
+            break;
+        case ONE_SHOT_TRIGGER:
+            if (stts->result == STTS22H_SUCCESS) {
+                stts->eventTime = now + CONVERSION_TIME[stts->settings.fields.avg];
+                stts->step = ONE_SHOT_CONVERSION;
+            } else {
+                stts->eventTime = now;
+                stts->step = ONE_SHOT_WAIT;
+            }
+            break;
+        case ONE_SHOT_CONVERSION:
+            if (isTimeReached(now, stts->eventTime)) {
+                if (startReading(stts, STTS22H_STATUS_ADDR, STATUS_READ_SIZE) == STTS22H_SUCCESS)
+                    stts->step = ONE_SHOT_READ;
+            }
+            break;
+        case ONE_SHOT_READ:
+            if (stts->result != STTS22H_SUCCESS || stts->status.fields.busy) {
+                stts->eventTime = now + BUSY_RETRY_TIME;
+                stts->step = ONE_SHOT_CONVERSION;
+            } else if (stts->period == 0) {
+                stts->mode = STTS22H_MODE_MANUAL;
+            } else {
+                stts->eventTime = stts->startTime + stts->period;
+                stts->step = ONE_SHOT_WAIT;
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Get the current output data rate of the streaming
+ * @param stts is the STTS22H data structure
+ * @return STTS22H_Rates values
+ */
+uint8_t STTS22H_getRate(const STTS22H_Def *stts) {
+    return stts->rate;
+}
+
+#if STTS22H_USE_ADAPTIVE
+
+/**
+ * @brief Turn ON/OFF the adaptive output data rate of the streaming: the rate of change is calculated every window,
+ * the fast change sets the maximum rate, the slow change during several windows decreases the rate by one step
+ * (the control register is written only when the rate is changed)
+ * @param stts is the STTS22H data structure
+ * @param adaptive is the controller configuration, it should exist while it is used (NULL - turn OFF)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_setAdaptive(STTS22H_Def *stts, const STTS22H_Adaptive_Def *adaptive) {
+    if (adaptive != NULL && (adaptive->window == 0 || adaptive->lower > adaptive->upper ||
+                             adaptive->minRate > adaptive->maxRate || adaptive->maxRate > STTS22H_RATE_200Hz))
         return STTS22H_WRONG_DATA;
 
-    uint8_t data[3] = {0};
-    data[0] = TEMP_H_LIMIT_ADDR;
-    if (isSetLimits) {
-        data[1] = calculateThreshold(maxTemp);
-        data[2] = calculateThreshold(minTemp);
+    stts->adaptive = NULL;
+    stts->hasReference = false;
+    stts->quiet = 0;
+    stts->adaptive = adaptive;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Calculate the rate of change and select the output data rate of the streaming (adaptive mode)
+ * @param stts is the STTS22H data structure
+ */
+static void processAdaptive(STTS22H_Def *stts) {
+    const STTS22H_Adaptive_Def *adaptive = stts->adaptive;
+    if (!stts->hasReference) {
+        stts->reference = stts->temp;
+        stts->referenceTime = stts->timestamp;
+        stts->hasReference = true;
+        return;
+    }
+
+    uint32_t elapsed = stts->timestamp - stts->referenceTime;
+    if (elapsed < adaptive->window)
+        return;
+
+    int32_t change = (int32_t) stts->temp - stts->reference;
+    if (change < 0)
+        change = -change;
+    uint32_t slope = (uint32_t) ((uint64_t) change * 1000000U / elapsed); // 0.01C/s
+    stts->reference = stts->temp;
+    stts->referenceTime = stts->timestamp;
+
+    uint8_t rate = stts->rate;
+    if (slope > adaptive->upper) {
+        rate = adaptive->maxRate;
+        stts->quiet = 0;
+    } else if (slope < adaptive->lower) {
+        if (++stts->quiet >= adaptive->hold) {
+            stts->quiet = 0;
+            if (rate > adaptive->minRate)
+                rate--;
+        }
+    } else {
+        stts->quiet = 0;
+    }
+    if (rate < adaptive->minRate)
+        rate = adaptive->minRate;
+    if (rate > adaptive->maxRate)
+        rate = adaptive->maxRate;
+
+    if (rate != stts->rate) {
+        stts->rate = rate;
+        stts->step = STREAM_SETUP; // the new control register value is staged by the next step
     }
+}
+
+#endif // STTS22H_USE_ADAPTIVE
+
+/**
+ * @brief Handle a new temperature value
+ * @param stts is the STTS22H data structure
+ */
+static void processSample(STTS22H_Def *stts) {
+    stts->timestamp = (stts->getTime != NULL) ? stts->getTime() : 0;
+    stts->sequence++;
+    if (stts->isNewSample)
+        stts->overruns++;
+    stts->isNewSample = true;
 
-    return I2C_writeData(stts->i2c, stts->devAddr, data, 3, true);
+#if STTS22H_USE_FIFO || STTS22H_USE_LOG
+    STTS22H_Sample_Def sample = {
+            .raw = stts->temp,
+            .status = stts->status,
+            .sequence = stts->sequence,
+            .timestamp = stts->timestamp
+    };
+#endif
+#if STTS22H_USE_FIFO
+    if (stts->fifo != NULL)
+        STTS22H_Fifo_push(stts->fifo, &sample);
+#endif
+#if STTS22H_USE_LOG
+    if (stts->log != NULL)
+        STTS22H_Log_encode(stts->log, &sample);
+#endif
+#if STTS22H_USE_FILTER
+    if (stts->filter != NULL && STTS22H_Filter_push(stts->filter, stts->temp) && stts->onFiltered != NULL)
+        stts->onFiltered(stts, STTS22H_Filter_getOutput(stts->filter));
+#endif
+    if (stts->onSample != NULL)
+        stts->onSample(stts, stts->temp);
+#if STTS22H_USE_DEADBAND
+    if (stts->useDeadband)
+        processDeadband(stts);
+#endif
+#if STTS22H_USE_ADAPTIVE
+    if (stts->adaptive != NULL && stts->mode == STTS22H_MODE_STREAMING)
+        processAdaptive(stts);
+#endif
 }
 
 /**
- * @brief Read the status and temperature registers values
+ * @brief Handle the threshold bits of the status register (they are reset by the status reading)
+ * @param stts is the STTS22H data structure
+ */
+static void processAlert(STTS22H_Def *stts) {
+#if STTS22H_USE_ALERT
+    if (stts->status.fields.over_thh && stts->onOverheat != NULL)
+        stts->onOverheat(stts, stts->temp);
+    if (stts->status.fields.under_thl && stts->onOvercool != NULL)
+        stts->onOvercool(stts, stts->temp);
+#else
+    (void) stts;
+#endif
+}
+
+/**
+ * @brief Start streaming: freerun mode, only the temperature registers are read with the output data rate
+ * (the status register is read by STTS22H_measure or by the ALERT/INT event)
  * @param stts is the STTS22H data structure
+ * @param avg is the output data rate (STTS22H_AVG values)
  * @return STTS22H_Errors values
  */
-int STTS22H_measure(STTS22H_Def *stts) {
+int STTS22H_startStreaming(STTS22H_Def *stts, uint8_t avg) {
     if (!isInit(stts))
         return STTS22H_NOT_INIT;
-    if (isReading(stts))
-        return STTS22H_BUSY;
-
-    stts->regAddr = STATUS_ADDR;
-    stts->dataSize = 3;
-
-    int result = I2C_writeData(stts->i2c, stts->devAddr, &stts->regAddr, sizeof(uint8_t), false);
-    if (result == I2C_SUCCESS)
-        stts->isReading = true;
+    if (stts->getTime == NULL || avg > STTS22H_AVG_200Hz)
+        return STTS22H_WRONG_DATA;
 
-    return result;
+    stts->rate = STTS22H_RATE_25Hz + avg;
+    stts->period = RATE_PERIOD[stts->rate];
+    stts->step = STREAM_SETUP;
+#if STTS22H_USE_ADAPTIVE
+    stts->hasReference = false;
+#endif
+    stts->mode = STTS22H_MODE_STREAMING;
+    return STTS22H_SUCCESS;
 }
 
 /**
- * @brief Get the last measured temperature value (C)
+ * @brief Stop streaming (the sensor stays in freerun mode, STTS22H_setting can turn it OFF)
  * @param stts is the STTS22H data structure
- * @return temperature value (degrees Celsius)
  */
-float STTS22H_getTemp_C(const STTS22H_Def *stts) {
-    return stts->temp;
+void STTS22H_stopStreaming(STTS22H_Def *stts) {
+    if (stts->mode == STTS22H_MODE_STREAMING)
+        stts->mode = STTS22H_MODE_MANUAL;
 }
 
 /**
- * @brief Get the last measured temperature value (F)
+ * @brief Move the streaming to the next step (there is no active transaction)
  * @param stts is the STTS22H data structure
- * @return temperature value (degrees Fahrenheit)
  */
-float STTS22H_getTemp_F(const STTS22H_Def *stts) {
-    float value = stts->temp;
-    value = 32.0f + value * 9.0f / 5.0f;
-    return value;
+static void processStreaming(STTS22H_Def *stts) {
+    uint32_t now = stts->getTime();
+
+    switch (stts->step) {
+        case STREAM_SETUP: {
+            STTS22H_Control_Def control = stts->settings;
+            control.fields.one_shot = 0;
+            control.fields.freerun = (stts->rate != STTS22H_RATE_1Hz);
+            control.fields.if_add_inc = 1;
+            if (stts->rate != STTS22H_RATE_1Hz)
+                control.fields.avg = (stts->rate - STTS22H_RATE_25Hz) & 0x03u;
+            control.fields.bdu = 1; // TEMP_L_OUT is read first
+            control.fields.low_odr_start = (stts->rate == STTS22H_RATE_1Hz);
+
+            stts->period = RATE_PERIOD[stts->rate];
+
+            stageRegister(stts, SHADOW_CTRL, control.full);
+            if (startRegisters(stts) == STTS22H_SUCCESS)
+                stts->step = STREAM_CONFIG;
+            break;
+        }
+        case STREAM_CONFIG:
+            if (stts->result == STTS22H_SUCCESS) {
+                stts->eventTime = now + stts->period;
+                stts->step = STREAM_WAIT;
+            } else {
+                stts->step = STREAM_SETUP;
+            }
+            break;
+        case STREAM_WAIT:
+            if (isTimeReached(now, stts->eventTime)) {
+                if (startReading(stts, STTS22H_TEMP_L_OUT_ADDR, TEMP_READ_SIZE) == STTS22H_SUCCESS)
+                    stts->step = STREAM_READ;
+            }
+            break;
+        case STREAM_READ:
+            stts->eventTime += stts->period;
+            if (isTimeReached(now, stts->eventTime))
+                stts->eventTime = now + stts->period; // the output data has been missed
+            stts->step = STREAM_WAIT;
+            break;
+    }
 }
 
 /**
- * @brief Check, that the temperature sensor has detected a value that is higher than the high limit
+ * @brief Check, that the periodic mode is waiting for the result of its own transaction
  * @param stts is the STTS22H data structure
- * @return True - is overheated, otherwise - False
+ * @return True - the result should be handled, otherwise - False
  */
-bool STTS22H_isOverheated(const STTS22H_Def *stts) {
-    return stts->status.fields.over_thh;
+static bool isModeResult(const STTS22H_Def *stts) {
+    switch (stts->mode) {
+        case STTS22H_MODE_ONE_SHOT:
+            return stts->step == ONE_SHOT_TRIGGER || stts->step == ONE_SHOT_READ;
+        case STTS22H_MODE_STREAMING:
+            return stts->step == STREAM_CONFIG || stts->step == STREAM_READ;
+        default:
+            return false;
+    }
 }
 
 /**
- * @brief Check, that the temperature sensor has detected a value that is lower than the low limit
+ * @brief Move the periodic mode to the next step (there is no active transaction)
  * @param stts is the STTS22H data structure
- * @return True - is overcooled, otherwise - False
  */
-bool STTS22H_isOvercooled(const STTS22H_Def *stts) {
-    return stts->status.fields.under_thl;
+static void processMode(STTS22H_Def *stts) {
+    switch (stts->mode) {
+        case STTS22H_MODE_ONE_SHOT:
+            processOneShot(stts);
+            break;
+        case STTS22H_MODE_STREAMING:
+            processStreaming(stts);
+            break;
+    }
 }
 
 /**
- * @brief Convert sensor register values to degrees
- * @param hOut is the "TEMP_H_OUT" register value
- * @param lOut is the "TEMP_L_OUT" register value
- * @return temperature value (degrees Celsius)
+ * @brief Check, that the sensor doesn't answer (several transactions have been failed one by one),
+ * the connection is checked by STTS22H_update with increasing intervals
+ * @param stts is the STTS22H data structure
+ * @return True - the sensor is degraded, otherwise - False
  */
-static float calculateTemp(uint8_t hOut, uint8_t lOut) {
-    // Datasheet, DS12606, Rev7, Aug 2022, page 17
+bool STTS22H_isDegraded(const STTS22H_Def *stts) {
+    return stts->isDegraded;
+}
 
-    int32_t temp = ((int32_t) hOut << 8) | lOut;
-    temp = (temp >= ((int32_t) 1 << 15)) ? (temp - ((int32_t) 1 << 16)) : temp;
-    return (float) temp / 100.0f;
+/**
+ * @brief Check, that the driver has its own work for STTS22H_update (events, periodic modes, recovery, unwritten settings)
+ * @param stts is the STTS22H data structure
+ * @return True - there is pending work, otherwise - False
+ */
+bool STTS22H_isPending(const STTS22H_Def *stts) {
+    return STTS22H_isAlertPending(stts) || stts->dirty != 0 || stts->isDegraded ||
+           stts->mode != STTS22H_MODE_MANUAL;
 }
 
 /**
- * @brief Update current state of the STTS22H
+ * @brief Start the transaction, that has been requested by the sensor events
  * @param stts is the STTS22H data structure
  */
-void STTS22H_update(STTS22H_Def *stts) {
-    if (!isInit(stts))
-        return;
-    if (!isReading(stts))
+static void startPending(STTS22H_Def *stts) {
+    if (stts->isDegraded) {
+        // without the time source the connection is checked only by STTS22H_checkConnection
+        if (stts->getTime != NULL && isTimeReached(stts->getTime(), stts->retryTime))
+            startReading(stts, STTS22H_WHOAMI_ADDR, WHOAMI_READ_SIZE);
         return;
+    }
+
+    // the result of the own periodic mode transaction is handled first
+    if (isModeResult(stts))
+        processMode(stts);
 
-    if (I2C_isReading(stts->i2c) || I2C_isWriting(stts->i2c))
+#if STTS22H_USE_ALERT
+    if (stts->alertPending) {
+        stts->alertPending = false;
+        if (startReading(stts, STTS22H_STATUS_ADDR, STATUS_READ_SIZE) == STTS22H_SUCCESS)
+            return;
+        stts->alertPending = true;
+    }
+#endif
+
+    // registers, that haven't been written (failed transfer or restored configuration)
+    if (stts->dirty != 0 && startRegisters(stts) == STTS22H_SUCCESS && isBusy(stts))
         return;
 
-    if (stts->addrSent) {
-        stts->addrSent = false;
-        stts->isReading = false;
+    processMode(stts);
+}
+
+/**
+ * @brief Move the transaction to the next step (the I2C interface has finished the previous transfer)
+ * @param stts is the STTS22H data structure
+ */
+static void processTransfer(STTS22H_Def *stts) {
+    const STTS22H_Transport_Def *transport = stts->transport;
+    bool isFailed = transport->isFailed(stts->i2c);
+
+    if (stts->phase == STTS22H_PHASE_WRITE) {
+        stts->phase = STTS22H_PHASE_IDLE;
+        statsFinish(stts, isFailed, stts->dataSize);
+        processHealth(stts, isFailed);
+
+        if (!isFailed) {
+            switch (stts->regAddr) {
+                case STTS22H_TEMP_H_LIMIT_ADDR:
+                case STTS22H_TEMP_L_LIMIT_ADDR:
+                case STTS22H_CTRL_ADDR:
+                    completeRegisters(stts);
+                    // the rest of the registers is written by the next transaction
+                    stts->settingResult = (stts->dirty == 0) ? STTS22H_SUCCESS : STTS22H_BUSY;
+                    break;
+            }
+            stts->result = STTS22H_SUCCESS;
+        } else {
+            stts->written = 0;
+            stts->result = STTS22H_FAILED;
+            stts->settingResult = STTS22H_FAILED;
+        }
+    } else if (stts->phase == STTS22H_PHASE_READ) {
+        stts->phase = STTS22H_PHASE_IDLE;
+        stts->result = isFailed ? STTS22H_FAILED : STTS22H_SUCCESS;
+        statsFinish(stts, isFailed, stts->dataSize + 1);
 
-        if (!I2C_isFailed(stts->i2c)) {
-            const uint8_t *data = (const uint8_t *) I2C_getReceivedData(stts->i2c);
+        if (!isFailed) {
+            const uint8_t *data = stts->isZeroCopy ? stts->rxData : transport->getReceivedData(stts->i2c);
             switch (stts->regAddr) {
-                case WHOAMI_ADDR:
+                case STTS22H_WHOAMI_ADDR:
                     stts->isConnected = (WHOAMI == *data);
                     break;
-                case TEMP_H_LIMIT_ADDR:
+                case STTS22H_TEMP_H_LIMIT_ADDR:
                     break;
-                case CTRL_ADDR:
+                case STTS22H_CTRL_ADDR:
                     break;
-                case STATUS_ADDR:
+                case STTS22H_STATUS_ADDR:
                     stts->status.full = data[0];
-                    if (!stts->status.fields.busy)
-                        stts->temp = calculateTemp(data[2], data[1]);
+                    if (!stts->status.fields.busy) {
+                        stts->temp = STTS22H_calculateRaw(data[2], data[1]);
+                        processSample(stts);
+                    }
+                    processAlert(stts);
                     break;
-                case TEMP_L_OUT_ADDR:
+                case STTS22H_TEMP_L_OUT_ADDR:
+                    // STATUS isn't read, the threshold bits of the previous reading aren't valid for this sample
+                    stts->status.full = 0;
+                    stts->temp = STTS22H_calculateRaw(data[1], data[0]);
+                    processSample(stts);
                     break;
             }
+        } else if (stts->regAddr == STTS22H_WHOAMI_ADDR) {
+            stts->isConnected = false; // the previous check isn't valid
         }
+
+        processHealth(stts, stts->result != STTS22H_SUCCESS || (stts->regAddr == STTS22H_WHOAMI_ADDR && !stts->isConnected));
+    } else if (isFailed) {
+        // the register address hasn't been acknowledged, the values of the previous address aren't read
+        stts->phase = STTS22H_PHASE_IDLE;
+        stts->result = STTS22H_FAILED;
+        if (stts->regAddr == STTS22H_WHOAMI_ADDR)
+            stts->isConnected = false;
+        statsFinish(stts, true, 0);
+        processHealth(stts, true);
     } else {
-        int result = I2C_readData(stts->i2c, stts->devAddr, stts->dataSize);
-        if (result == I2C_SUCCESS)
-            stts->addrSent = true;
+        stts->phase = STTS22H_PHASE_READ;
+        stts->isZeroCopy = (transport->readInto != NULL);
+
+        int result;
+        if (transport->readInto != NULL)
+            result = transport->readInto(stts->i2c, stts->devAddr, stts->regAddr, stts->rxData, stts->dataSize);
         else
-            stts->isReading = false;
+            result = transport->read(stts->i2c, stts->devAddr, stts->regAddr, stts->dataSize);
+        if (result != I2C_SUCCESS) {
+            statsFinish(stts, true, 0);
+            stts->phase = STTS22H_PHASE_IDLE;
+            stts->result = (int16_t) result;
+            if (stts->regAddr == STTS22H_WHOAMI_ADDR)
+                stts->isConnected = false;
+            processHealth(stts, true);
+        }
+    }
+
+    if (!isBusy(stts))
+        finishTransaction(stts);
+}
+
+/**
+ * @brief Update current state of the STTS22H
+ * @param stts is the STTS22H data structure
+ */
+void STTS22H_update(STTS22H_Def *stts) {
+    if (!isInit(stts))
+        return;
+
+    // the transfers of the interrupt mode are finished only by STTS22H_transferComplete
+    if (isBusy(stts) && !stts->isInterruptMode) {
+        if (stts->transport->isBusy(stts->i2c))
+            return;
+
+        processTransfer(stts);
     }
+
+    if (!isBusy(stts))
+        startPending(stts);
+}
+
+/**
+ * @brief Turn ON/OFF the interrupt mode: the transfers are finished only by STTS22H_transferComplete
+ * (STTS22H_update is still required for the events, the periodic modes, the recovery and it starts the new transactions)
+ * @param stts is the STTS22H data structure
+ * @param isEnabled is a flag (True - the interrupt mode, False - the transfers are polled by STTS22H_update)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_setInterruptMode(STTS22H_Def *stts, bool isEnabled) {
+    if (!isInit(stts))
+        return STTS22H_NOT_INIT;
+    if (isBusy(stts))
+        return STTS22H_BUSY;
+
+    stts->isInterruptMode = isEnabled;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief The I2C transfer has been completed (it should be called from the I2C/DMA interrupt handler).
+ * The next transfers of the current transaction are started here, the new transactions of the driver (events,
+ * periodic modes, recovery) are started only by STTS22H_update, so one context checks and starts them
+ * @param stts is the STTS22H data structure
+ */
+void STTS22H_transferComplete(STTS22H_Def *stts) {
+    if (!isInit(stts))
+        return;
+    if (!isBusy(stts))
+        return;
+    // the late completion of the previous transfer, the current transfer is in progress
+    if (stts->transport->isBusy(stts->i2c))
+        return;
+
+    processTransfer(stts);
 }
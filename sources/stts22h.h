@@ -1,11 +1,109 @@
 #ifndef STTS22H_H
 #define STTS22H_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef STTS22H_USE_I2C_DRIVER
+#define STTS22H_USE_I2C_DRIVER 1 // 0 - i2c.h isn't used, the platform transport is set by STTS22H_setTransport
+#endif
+
+#ifndef STTS22H_USE_FLOAT
+#define STTS22H_USE_FLOAT 1 // 0 - only the integer (0.01 degrees) API is built
+#endif
+
+#ifndef STTS22H_USE_ALERT
+#define STTS22H_USE_ALERT 1 // 0 - the ALERT/INT event mode and the threshold callbacks aren't built
+#endif
+
+#ifndef STTS22H_USE_FIFO
+#define STTS22H_USE_FIFO 1 // 0 - the ring buffer can't be attached
+#endif
+
+#ifndef STTS22H_USE_FILTER
+#define STTS22H_USE_FILTER 1 // 0 - the filter can't be attached
+#endif
+
+#ifndef STTS22H_USE_LOG
+#define STTS22H_USE_LOG 1 // 0 - the compact log encoder can't be attached
+#endif
+
+#ifndef STTS22H_USE_STATS
+#define STTS22H_USE_STATS 0 // 1 - the transactions statistics are collected
+#endif
+
+#ifndef STTS22H_USE_OS
+#define STTS22H_USE_OS 0 // 1 - the driver can be used by several tasks (OS abstraction layer)
+#endif
+
+#ifndef STTS22H_USE_DEADBAND
+#define STTS22H_USE_DEADBAND 0 // 1 - the change detection (deadband and heartbeat of the significant samples)
+#endif
+
+#ifndef STTS22H_USE_ADAPTIVE
+#define STTS22H_USE_ADAPTIVE 0 // 1 - the adaptive output data rate of the streaming
+#endif
+
+#ifndef STTS22H_POOL_SIZE
+#define STTS22H_POOL_SIZE 0 // number of the statically allocated instances of STTS22H_alloc (0 - there is no pool)
+#endif
+
+#ifndef STTS22H_ADDRESS_SHIFT
+#define STTS22H_ADDRESS_SHIFT 0 // 1 - the I2C interface uses the left-aligned (8-bit) device addresses
+#endif
+
+#ifndef STTS22H_MAX_FAILURES
+#define STTS22H_MAX_FAILURES 3 // consecutive failed transactions, then the sensor is degraded
+#endif
+
+#ifndef STTS22H_RECONNECT_MIN_TIME
+#define STTS22H_RECONNECT_MIN_TIME 10000UL // us, first interval of the connection check
+#endif
+
+#ifndef STTS22H_RECONNECT_MAX_TIME
+#define STTS22H_RECONNECT_MAX_TIME 5000000UL // us, the interval is doubled up to this value
+#endif
+
+// performance budgets, bus bytes per sample (the device address isn't counted), they are checked by the test
+// on the simulated bus (tests/stts22h_test.c)
+#define STTS22H_BUDGET_MEASURE_BYTES 4 // STTS22H_measure: register address, STATUS, TEMP_L_OUT, TEMP_H_OUT
+#define STTS22H_BUDGET_ONE_SHOT_BYTES 6 // the "one_shot" bit write (CTRL only) and STTS22H_measure
+#define STTS22H_BUDGET_STREAMING_BYTES 3 // register address, TEMP_L_OUT, TEMP_H_OUT
+// bytes of STTS22H_Def (it is checked at compile time): the target of the default options is 160 bytes
+// on 64-bit targets (144 bytes are used), every optional feature has its own part
+#define STTS22H_BUDGET_DATA_SIZE (10 * sizeof(void *) + 80 + (STTS22H_USE_STATS ? 40 : 0) + \
+                                  (STTS22H_USE_OS ? 2 * sizeof(void *) : 0) + \
+                                  (STTS22H_USE_DEADBAND ? sizeof(void *) + 12 : 0) + \
+                                  (STTS22H_USE_ADAPTIVE ? sizeof(void *) + 8 : 0))
+
+#if STTS22H_USE_OS
+#ifdef __cplusplus
+#include <atomic>
+using std::atomic_flag; // the same layout as atomic_flag of C11
+#else
+#include <stdatomic.h>
+#endif
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#include "i2c.h"
+#if STTS22H_USE_I2C_DRIVER
+#include "i2c.h" // the C header of the MCU I2C driver
+#else
+// the bus of the platform transport (e.g. the i2c-dev channel of stts22h_linux.h), it is defined by the transport
+typedef struct I2CDef I2CDef;
+
+// result codes of the platform transport
+enum I2C_Errors {
+    I2C_SUCCESS = 0,
+    I2C_FAILED = -1,
+
+    I2C_NUMBER_ERRORS = 2
+};
+#endif
 
 enum STTS22H_Errors {
     STTS22H_SUCCESS = 0,
@@ -13,6 +111,29 @@ enum STTS22H_Errors {
     STTS22H_NOT_INIT = -I2C_NUMBER_ERRORS - 1,
     STTS22H_WRONG_DATA = -I2C_NUMBER_ERRORS - 2,
     STTS22H_BUSY = -I2C_NUMBER_ERRORS - 3,
+    STTS22H_FAILED = -I2C_NUMBER_ERRORS - 4,
+    STTS22H_NOT_CONNECTED = -I2C_NUMBER_ERRORS - 5,
+};
+
+// 7-bit device addresses, that are selected by the ADDR pin (Datasheet, DS12606, Rev7, Aug 2022, page 11)
+enum STTS22H_Addresses {
+    STTS22H_ADDRESS_0 = 0x38,
+    STTS22H_ADDRESS_1 = 0x3C,
+    STTS22H_ADDRESS_2 = 0x3E,
+    STTS22H_ADDRESS_3 = 0x3F,
+};
+
+#define STTS22H_ADDRESS(addr) ((uint8_t) ((addr) << STTS22H_ADDRESS_SHIFT)) // address of the I2C interface
+
+// register addresses of the sensor
+enum STTS22H_RegAddresses {
+    STTS22H_WHOAMI_ADDR = 0x01,
+    STTS22H_TEMP_H_LIMIT_ADDR,
+    STTS22H_TEMP_L_LIMIT_ADDR,
+    STTS22H_CTRL_ADDR,
+    STTS22H_STATUS_ADDR,
+    STTS22H_TEMP_L_OUT_ADDR,
+    STTS22H_TEMP_H_OUT_ADDR
 };
 
 enum STTS22H_AVG {
@@ -22,68 +143,449 @@ enum STTS22H_AVG {
     STTS22H_AVG_200Hz,
 };
 
+enum STTS22H_Rates {
+    STTS22H_RATE_1Hz = 0, // low_odr_start mode
+    STTS22H_RATE_25Hz, // freerun mode, STTS22H_AVG values + 1
+    STTS22H_RATE_50Hz,
+    STTS22H_RATE_100Hz,
+    STTS22H_RATE_200Hz,
+};
+
+enum STTS22H_Units {
+    STTS22H_CELSIUS = 0,
+    STTS22H_FAHRENHEIT,
+    STTS22H_KELVIN,
+};
+
 typedef union {
     struct STTS22H_ControlRegister {
-        unsigned one_shot: 1; // 1 - a new one-shot temperature acquisition is executed
-        unsigned time_out_dis: 1; // 1 - the timeout function of SMBus is disabled
-        unsigned freerun: 1; // enables freerun mode
-        unsigned if_add_inc: 1; // 1 - the automatic address increment is enabled when multiple I2C read and write transactions are used
-        unsigned avg: 2; // set the number of averages configuration. When in freerun mode, these bits also set the ODR
-        unsigned bdu: 1; // 1 - BDU enabled (if BDU is used, TEMP_L_OUT must be read first)
-        unsigned low_odr_start: 1; // enables 1Hz ODR operating mode
+        uint8_t one_shot: 1; // 1 - a new one-shot temperature acquisition is executed
+        uint8_t time_out_dis: 1; // 1 - the timeout function of SMBus is disabled
+        uint8_t freerun: 1; // enables freerun mode
+        uint8_t if_add_inc: 1; // 1 - the automatic address increment is enabled when multiple I2C read and write transactions are used
+        uint8_t avg: 2; // set the number of averages configuration. When in freerun mode, these bits also set the ODR
+        uint8_t bdu: 1; // 1 - BDU enabled (if BDU is used, TEMP_L_OUT must be read first)
+        uint8_t low_odr_start: 1; // enables 1Hz ODR operating mode
     } fields;
     uint8_t full;
 } STTS22H_Control_Def;
 
 typedef union {
     struct STTS22H_StatusRegister {
-        unsigned busy: 1; // 1 - the conversion is in progress
-        unsigned over_thh: 1; // 1 - high limit temperature exceeded. The bit is automatically reset to 0 upon reading the STATUS register
-        unsigned under_thl: 1; // 1 - low limit temperature exceeded. The bit is automatically reset to 0 upon reading the STATUS register
-        unsigned : 5;
+        uint8_t busy: 1; // 1 - the conversion is in progress
+        uint8_t over_thh: 1; // 1 - high limit temperature exceeded. The bit is automatically reset to 0 upon reading the STATUS register
+        uint8_t under_thl: 1; // 1 - low limit temperature exceeded. The bit is automatically reset to 0 upon reading the STATUS register
+        uint8_t : 5;
     } fields;
     uint8_t full;
 } STTS22H_Status_Def;
 
+/**
+ * @brief Optional combined transfer: write the register address and read the register values (repeated START)
+ * @param i2c is the base I2C interface data structure
+ * @param devAddr is the device address (on I2C bus)
+ * @param regAddr is the pointer to the first register address
+ * @param data is the destination buffer (the received values are written directly into it, e.g. by DMA)
+ * @param dataSize is the number of bytes that should be read
+ * @return I2C_Errors values
+ */
+typedef int (*STTS22H_WriteRead_Def)(I2CDef *i2c, uint8_t devAddr, const uint8_t *regAddr, uint8_t *data,
+                                     uint8_t dataSize);
+
+/**
+ * @brief Optional reading directly into the buffer of the driver (without the intermediate buffer of the I2C interface)
+ * @param i2c is the base I2C interface data structure
+ * @param devAddr is the device address (on I2C bus)
+ * @param regAddr is the first register address (it has been written by the previous transfer)
+ * @param data is the destination buffer
+ * @param dataSize is the number of bytes that should be read
+ * @return I2C_Errors values
+ */
+typedef int (*STTS22H_ReadInto_Def)(I2CDef *i2c, uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint8_t dataSize);
+
+/**
+ * Transfer primitives of the platform (e.g. i2c-dev with I2C_RDWR messages, DMA HAL, SMBus with PEC - the checksum
+ * is added and checked by the transport), the default transport is STTS22H_I2C_TRANSPORT (functions of i2c.h,
+ * STTS22H_USE_I2C_DRIVER = 1).
+ * The non-blocking transfers are finished by STTS22H_update (isBusy) or by STTS22H_transferComplete (interrupt mode)
+ */
 typedef struct {
-    bool isInit;
-    bool isConnected;
+    // write data (I2C_Errors values), the non-blocking transfer keeps the data pointer until its end
+    int (*write)(I2CDef *i2c, uint8_t devAddr, const uint8_t *data, uint8_t dataSize, bool isBlocking);
+    // start reading into the buffer of the transport (I2C_Errors values), regAddr has been written by the previous
+    // transfer (e.g. the SMBus PEC of the reading covers the device address, the register address and the values)
+    int (*read)(I2CDef *i2c, uint8_t devAddr, uint8_t regAddr, uint8_t dataSize);
+    // pointer to the received data of the last reading
+    const uint8_t *(*getReceivedData)(I2CDef *i2c);
+    // the transfer is in progress
+    bool (*isBusy)(I2CDef *i2c);
+    // the last transfer has been failed (NACK, bus error, wrong checksum)
+    bool (*isFailed)(I2CDef *i2c);
+    STTS22H_WriteRead_Def writeRead; // NULL - the register address and the values are transferred separately
+    STTS22H_ReadInto_Def readInto; // NULL - the values are taken from the buffer of the transport
+} STTS22H_Transport_Def;
 
-    bool isReading;
-    bool addrSent;
-    uint8_t regAddr;
+#if STTS22H_USE_I2C_DRIVER
+
+extern const STTS22H_Transport_Def STTS22H_I2C_TRANSPORT;
+
+#endif // STTS22H_USE_I2C_DRIVER
+
+enum STTS22H_Phases {
+    STTS22H_PHASE_IDLE = 0,
+    STTS22H_PHASE_WRITE, // the register values are being written
+    STTS22H_PHASE_ADDRESS, // the register address is being written before the reading
+    STTS22H_PHASE_READ, // the register values are being read
+};
+
+enum STTS22H_Modes {
+    STTS22H_MODE_MANUAL = 0, // transactions are started by the application
+    STTS22H_MODE_ONE_SHOT, // periodic one-shot conversions (power-down between them)
+    STTS22H_MODE_STREAMING, // freerun mode, only the temperature registers are read
+};
+
+/**
+ * @brief Time source, that is used by the periodic modes and the sample timestamps
+ * @return current time (microseconds, free-running counter)
+ */
+typedef uint32_t (*STTS22H_GetTime_Def)(void);
+
+typedef struct {
+    int16_t raw; // 0.01C
+    STTS22H_Status_Def status; // 0 - the streaming reads only TEMP_L_OUT/TEMP_H_OUT (ALERT mode reports the thresholds)
+    uint16_t sequence; // number of the sample
+    uint32_t timestamp; // time of the reading end (STTS22H_GetTime_Def units, 0 - there is no time source)
+} STTS22H_Sample_Def;
+
+typedef struct {
+    uint64_t totalLatency; // us, average value = totalLatency / completed (32 bits are overflowed after ~72 minutes)
+    uint32_t started; // number of the started transactions
+    uint32_t completed; // number of the successful transactions
+    uint32_t failed; // number of the failed transfers
+    uint32_t rejected; // number of the requests, that have been rejected (STTS22H_BUSY)
+    uint32_t bytes; // number of the transferred bytes (device address isn't counted)
+    uint32_t minLatency; // us, it requires the time source
+    uint32_t maxLatency; // us
+} STTS22H_Stats_Def;
+
+/**
+ * Samples of several sensors (struct-of-arrays), the arrays are provided by the application
+ */
+typedef struct {
+    uint16_t upper; // 0.01C/s, the faster change - the maximum rate
+    uint16_t lower; // 0.01C/s, the slower change (during several windows) - the rate is decreased by one step
+    uint32_t window; // us, interval of the rate of change calculation
+    uint8_t hold; // number of the slow windows before the rate is decreased
+    uint8_t minRate; // STTS22H_Rates values
+    uint8_t maxRate; // STTS22H_Rates values
+} STTS22H_Adaptive_Def;
+
+typedef struct {
+    int16_t *temp; // 0.01C
+    uint8_t *status; // STTS22H_Status_Def.full
+    uint16_t *sequence; // number of the sample
+} STTS22H_Batch_Def;
+
+/**
+ * OS abstraction layer (e.g. FreeRTOS mutex and task notifications)
+ */
+typedef struct {
+    bool (*lockBus)(I2CDef *i2c); // take the bus without waiting (True - it has been taken), NULL - not used
+    void (*unlockBus)(I2CDef *i2c);
+    void *(*getTask)(void); // handle of the current task
+    bool (*wait)(uint32_t timeout); // sleep until the notification (False - timeout)
+    void (*notify)(void *task); // wake up the task (it can be called from the interrupt handler)
+} STTS22H_OS_Def;
+
+struct STTS22H_Data;
+struct STTS22H_Fifo_Data;
+struct STTS22H_Filter_Data;
+struct STTS22H_LogEncoder_Data;
+
+/**
+ * @brief Optional callback, that is called when a new temperature value has been measured
+ * @param stts is the STTS22H data structure
+ * @param temp is the temperature value (0.01 degrees Celsius)
+ */
+typedef void (*STTS22H_SampleCallback_Def)(struct STTS22H_Data *stts, int16_t temp);
+
+// the fields are ordered by their size (there is no padding between them)
+typedef struct STTS22H_Data {
+    I2CDef *i2c;
+    const STTS22H_Transport_Def *transport;
+    STTS22H_GetTime_Def getTime;
+    STTS22H_SampleCallback_Def onSample;
+#if STTS22H_USE_DEADBAND
+    STTS22H_SampleCallback_Def onSignificant;
+#endif
+#if STTS22H_USE_ALERT
+    STTS22H_SampleCallback_Def onOverheat;
+    STTS22H_SampleCallback_Def onOvercool;
+#endif
+#if STTS22H_USE_FIFO
+    struct STTS22H_Fifo_Data *fifo; // NULL - samples are not buffered
+#endif
+#if STTS22H_USE_FILTER
+    struct STTS22H_Filter_Data *filter; // NULL - samples are not filtered
+    STTS22H_SampleCallback_Def onFiltered;
+#endif
+#if STTS22H_USE_LOG
+    struct STTS22H_LogEncoder_Data *log; // NULL - samples are not logged
+#endif
+#if STTS22H_USE_ADAPTIVE
+    const STTS22H_Adaptive_Def *adaptive; // NULL - the streaming rate is fixed
+#endif
+#if STTS22H_USE_OS
+    const STTS22H_OS_Def *os;
+    void *volatile waiter; // task, that is waiting for the end of the transaction
+#endif
+
+    uint32_t timestamp; // time of the last temperature value
+    uint32_t overruns; // number of the values, that have been replaced before STTS22H_getSample
+    uint32_t period; // us
+    uint32_t startTime; // us, time of the current period start
+    uint32_t eventTime; // us, time of the next step
+    uint32_t retryTime; // us, time of the next connection check
+#if STTS22H_USE_DEADBAND
+    uint32_t heartbeat; // us, maximum interval between the significant samples (0 - not used)
+    uint32_t reportTime; // time of the last significant value
+#endif
+#if STTS22H_USE_ADAPTIVE
+    uint32_t referenceTime; // us, time of the window start (adaptive rate)
+#endif
+#if STTS22H_USE_STATS
+    STTS22H_Stats_Def stats;
+    uint32_t transferTime; // us, start of the current transaction
+#endif
 
+    int16_t result; // result of the last transaction (STTS22H_Errors values)
+    int16_t settingResult; // result of the last register write (STTS22H_Errors values)
+    int16_t temp; // 0.01C
+    uint16_t sequence; // it is incremented with every new temperature value
+#if STTS22H_USE_DEADBAND
+    uint16_t deadband; // 0.01C, minimum change of the significant sample
+    int16_t reported; // 0.01C, the last significant value
+#endif
+#if STTS22H_USE_ADAPTIVE
+    int16_t reference; // 0.01C, value at the window start (adaptive rate)
+#endif
+
+    volatile uint8_t phase; // STTS22H_Phases values, it is changed by the interrupt
+    uint8_t devAddr;
+    uint8_t regAddr;
     uint8_t dataSize; // bytes
-    STTS22H_Control_Def settings;
+    uint8_t txData[4]; // register address and values of the asynchronous write
+    uint8_t rxData[3]; // raw register values
+    uint8_t written; // shadow copies, that are being written
+    STTS22H_Control_Def settings; // shadow copy of CTRL
+    uint8_t limits[2]; // shadow copies of TEMP_H_LIMIT and TEMP_L_LIMIT
+    uint8_t cached; // shadow copies, that are equal to the sensor registers (bit 0 - TEMP_H_LIMIT, ..., bit 2 - CTRL)
+    uint8_t dirty; // shadow copies, that should be written to the sensor
     STTS22H_Status_Def status;
-    float temp; // C
+    uint8_t mode; // STTS22H_Modes values
+    uint8_t step; // step of the periodic mode
+    uint8_t rate; // STTS22H_Rates values, output data rate of the streaming
+    uint8_t failures; // consecutive failed transactions
+    uint8_t retries; // failed connection checks of the degraded sensor (the interval is doubled by every one)
+#if STTS22H_USE_ADAPTIVE
+    uint8_t quiet; // number of the slow windows one by one (adaptive rate)
+#endif
+#if STTS22H_USE_OS
+    atomic_flag lock; // the check and the start of the transaction
+#endif
+#if STTS22H_USE_ALERT
+    volatile bool alertPending; // it is set by the ALERT/INT pin interrupt
+#endif
 
-    uint8_t devAddr;
-    I2CDef *i2c;
+    // the flags, that are set by the transaction and cleared by the application, are not packed
+    bool isNewSample; // the last temperature value hasn't been taken by STTS22H_getSample
+#if STTS22H_USE_DEADBAND
+    bool isSignificant; // the last sample is significant (it hasn't been cleared)
+#endif
+#if STTS22H_USE_ADAPTIVE
+    bool hasReference; // the reference value of the rate of change has been taken
+#endif
+
+    // every byte of the flags is changed by one context only
+    bool isInit: 1;
+#if STTS22H_USE_DEADBAND
+    bool useDeadband: 1;
+#endif
+    bool isInterruptMode: 1; // the transfers are finished only by STTS22H_transferComplete
+    bool : 0;
+    // they are changed only by the owner of the transaction
+    bool isConnected: 1;
+    bool isDegraded: 1; // the sensor doesn't answer, the connection is being restored
+    bool isZeroCopy: 1; // the values of the current transaction are received into rxData
+    bool isAutoIncrement: 1; // the sensor has IF_ADD_INC (the registers can be written by one burst)
 } STTS22H_Def;
 
+/**
+ * @brief Convert sensor register values to the signed raw value
+ * @param hOut is the "TEMP_H_OUT" register value
+ * @param lOut is the "TEMP_L_OUT" register value
+ * @return temperature value (0.01 degrees Celsius)
+ */
+static inline int16_t STTS22H_calculateRaw(uint8_t hOut, uint8_t lOut) {
+    // Datasheet, DS12606, Rev7, Aug 2022, page 17
+
+    int32_t temp = ((int32_t) hOut << 8) | lOut;
+    temp = (temp >= ((int32_t) 1 << 15)) ? (temp - ((int32_t) 1 << 16)) : temp;
+    return (int16_t) temp;
+}
+
 int STTS22H_init(STTS22H_Def *stts, I2CDef *i2c, uint8_t addr);
 
+#if STTS22H_POOL_SIZE > 0
+
+STTS22H_Def *STTS22H_alloc(I2CDef *i2c, uint8_t addr);
+
+#endif // STTS22H_POOL_SIZE
+
+int STTS22H_setTransport(STTS22H_Def *stts, const STTS22H_Transport_Def *transport);
+
 int STTS22H_checkConnection(STTS22H_Def *stts);
 
 bool STTS22H_isConnected(const STTS22H_Def *stts);
 
+bool STTS22H_isBusy(const STTS22H_Def *stts);
+
+bool STTS22H_isDegraded(const STTS22H_Def *stts);
+
+bool STTS22H_isPending(const STTS22H_Def *stts);
+
+int STTS22H_getResult(const STTS22H_Def *stts);
+
+int STTS22H_getSettingResult(const STTS22H_Def *stts);
+
+#if STTS22H_USE_STATS
+
+void STTS22H_getStats(const STTS22H_Def *stts, STTS22H_Stats_Def *stats);
+
+void STTS22H_resetStats(STTS22H_Def *stts);
+
+#endif // STTS22H_USE_STATS
+
 int STTS22H_setting(STTS22H_Def *stts, uint8_t controlReg);
 
-int STTS22H_setLimits(STTS22H_Def *stts, float minTemp, float maxTemp, bool isSetLimits);
+int STTS22H_settingAsync(STTS22H_Def *stts, uint8_t controlReg);
+
+int STTS22H_setLimits_cC(STTS22H_Def *stts, int16_t minTemp, int16_t maxTemp, bool isSetLimits);
+
+int STTS22H_setLimitsAsync_cC(STTS22H_Def *stts, int16_t minTemp, int16_t maxTemp, bool isSetLimits);
+
+int STTS22H_configureAsync(STTS22H_Def *stts, uint8_t controlReg, int16_t minTemp, int16_t maxTemp, bool isSetLimits);
+
+void STTS22H_invalidateCache(STTS22H_Def *stts);
 
 int STTS22H_measure(STTS22H_Def *stts);
 
+uint32_t STTS22H_getConversionTime(const STTS22H_Def *stts);
+
+#if STTS22H_USE_OS
+
+void STTS22H_setOS(STTS22H_Def *stts, const STTS22H_OS_Def *os);
+
+int STTS22H_measureWait(STTS22H_Def *stts, uint32_t timeout);
+
+#endif // STTS22H_USE_OS
+
+int16_t STTS22H_getTemp_cC(const STTS22H_Def *stts);
+
+int32_t STTS22H_getTemp_cF(const STTS22H_Def *stts);
+
+int STTS22H_convertBulk(const int16_t *temp, size_t number, int32_t *out, uint8_t unit);
+
+#if STTS22H_USE_FLOAT
+
+int STTS22H_setLimits(STTS22H_Def *stts, float minTemp, float maxTemp, bool isSetLimits);
+
+int STTS22H_setLimitsAsync(STTS22H_Def *stts, float minTemp, float maxTemp, bool isSetLimits);
+
 float STTS22H_getTemp_C(const STTS22H_Def *stts);
 
 float STTS22H_getTemp_F(const STTS22H_Def *stts);
 
+int STTS22H_convertBulkFloat(const int16_t *temp, size_t number, float *out, uint8_t unit);
+
+#endif // STTS22H_USE_FLOAT
+
+bool STTS22H_getSample(STTS22H_Def *stts, STTS22H_Sample_Def *sample);
+
+uint32_t STTS22H_getOverruns(const STTS22H_Def *stts);
+
+int STTS22H_readBatch(const STTS22H_Def *const *stts, size_t number, STTS22H_Batch_Def *out);
+
 bool STTS22H_isOverheated(const STTS22H_Def *stts);
 
 bool STTS22H_isOvercooled(const STTS22H_Def *stts);
 
+void STTS22H_setSampleCallback(STTS22H_Def *stts, STTS22H_SampleCallback_Def onSample);
+
+#if STTS22H_USE_ALERT
+
+void STTS22H_setAlertCallbacks(STTS22H_Def *stts, STTS22H_SampleCallback_Def onOverheat,
+                               STTS22H_SampleCallback_Def onOvercool);
+
+void STTS22H_alertHandler(STTS22H_Def *stts);
+
+#endif // STTS22H_USE_ALERT
+
+bool STTS22H_isAlertPending(const STTS22H_Def *stts);
+
+void STTS22H_setTimeSource(STTS22H_Def *stts, STTS22H_GetTime_Def getTime);
+
+int STTS22H_startOneShot(STTS22H_Def *stts, uint32_t period);
+
+void STTS22H_stopOneShot(STTS22H_Def *stts);
+
+int STTS22H_startStreaming(STTS22H_Def *stts, uint8_t avg);
+
+void STTS22H_stopStreaming(STTS22H_Def *stts);
+
+uint8_t STTS22H_getRate(const STTS22H_Def *stts);
+
+#if STTS22H_USE_ADAPTIVE
+
+int STTS22H_setAdaptive(STTS22H_Def *stts, const STTS22H_Adaptive_Def *adaptive);
+
+#endif // STTS22H_USE_ADAPTIVE
+
+#if STTS22H_USE_DEADBAND
+
+void STTS22H_setDeadband(STTS22H_Def *stts, uint16_t deadband, uint32_t heartbeat,
+                         STTS22H_SampleCallback_Def onSignificant);
+
+bool STTS22H_isSignificant(const STTS22H_Def *stts);
+
+void STTS22H_clearSignificant(STTS22H_Def *stts);
+
+#endif // STTS22H_USE_DEADBAND
+
+#if STTS22H_USE_FIFO
+
+void STTS22H_attachFifo(STTS22H_Def *stts, struct STTS22H_Fifo_Data *fifo);
+
+#endif // STTS22H_USE_FIFO
+
+#if STTS22H_USE_FILTER
+
+void STTS22H_attachFilter(STTS22H_Def *stts, struct STTS22H_Filter_Data *filter, STTS22H_SampleCallback_Def onFiltered);
+
+#endif // STTS22H_USE_FILTER
+
+#if STTS22H_USE_LOG
+
+void STTS22H_attachLog(STTS22H_Def *stts, struct STTS22H_LogEncoder_Data *log);
+
+#endif // STTS22H_USE_LOG
+
 void STTS22H_update(STTS22H_Def *stts);
 
+int STTS22H_setInterruptMode(STTS22H_Def *stts, bool isEnabled);
+
+void STTS22H_transferComplete(STTS22H_Def *stts);
+
 #ifdef __cplusplus
 }
 #endif
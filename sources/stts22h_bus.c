@@ -0,0 +1,690 @@
+#include "stts22h_bus.h"
+
+/**
+ * @brief Check, that the bus scheduler is initialized
+ * @param bus is the bus scheduler data structure
+ * @return True - scheduler has been initialized, otherwise - False
+ */
+static bool isInit(const STTS22H_Bus_Def *bus) {
+    return bus->isInit;
+}
+
+/**
+ * @brief Get the number of the registered sensors (it is bounded by the arrays size for the compiler too)
+ * @param bus is the bus scheduler data structure
+ * @return number of the sensors
+ */
+static uint8_t getNumber(const STTS22H_Bus_Def *bus) {
+    return (bus->number < STTS22H_BUS_MAX_SENSORS) ? bus->number : STTS22H_BUS_MAX_SENSORS;
+}
+
+/**
+ * @brief Check, that the sensor index is valid
+ * @param bus is the bus scheduler data structure
+ * @param index is the sensor index (order of STTS22H_Bus_addSensor calls)
+ * @return True - sensor is registered, otherwise - False
+ */
+static bool isValid(const STTS22H_Bus_Def *bus, uint8_t index) {
+    return index < getNumber(bus);
+}
+
+/**
+ * @brief The bus scheduler initialization
+ * @param bus is the bus scheduler data structure
+ * @param i2c is the base I2C interface data structure, that is shared by all sensors
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Bus_init(STTS22H_Bus_Def *bus, I2CDef *i2c) {
+    if (bus == NULL || i2c == NULL)
+        return STTS22H_WRONG_DATA;
+
+    bus->number = 0;
+    bus->current = 0;
+    bus->last = 0;
+    bus->active = 0;
+    bus->getTime = NULL;
+    bus->onMissed = NULL;
+    bus->snapshotStep = STTS22H_SNAPSHOT_IDLE;
+    bus->isDiscovery = false;
+    bus->presence = 0;
+    bus->config = NULL;
+    bus->i2c = i2c;
+    bus->isInit = true;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Register the temperature sensor (it must be initialized with the same I2C interface)
+ * @param bus is the bus scheduler data structure
+ * @param stts is the STTS22H data structure
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Bus_addSensor(STTS22H_Bus_Def *bus, STTS22H_Def *stts) {
+    if (!isInit(bus))
+        return STTS22H_NOT_INIT;
+    if (stts == NULL || !stts->isInit || stts->i2c != bus->i2c)
+        return STTS22H_WRONG_DATA;
+    if (bus->number >= STTS22H_BUS_MAX_SENSORS)
+        return STTS22H_WRONG_DATA;
+    if (STTS22H_Bus_isBusy(bus))
+        return STTS22H_BUSY;
+
+    bus->requests[bus->number] = 0;
+    bus->settings[bus->number] = 0;
+    bus->priorities[bus->number] = 0;
+    bus->isDeadline[bus->number] = false;
+    bus->missed[bus->number] = 0;
+    bus->sensors[bus->number] = stts;
+    bus->number++;
+    bus->current = bus->number;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Queue the connection check ("WHOAMI" register reading)
+ * @param bus is the bus scheduler data structure
+ * @param index is the sensor index
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Bus_checkConnection(STTS22H_Bus_Def *bus, uint8_t index) {
+    if (!isInit(bus))
+        return STTS22H_NOT_INIT;
+    if (!isValid(bus, index))
+        return STTS22H_WRONG_DATA;
+
+    bus->requests[index] |= STTS22H_BUS_CHECK_CONNECTION;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Queue the sensor setting (the last queued value is written)
+ * @param bus is the bus scheduler data structure
+ * @param index is the sensor index
+ * @param controlReg is the control register value (STTS22H_ControlReg_Def.full)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Bus_setting(STTS22H_Bus_Def *bus, uint8_t index, uint8_t controlReg) {
+    if (!isInit(bus))
+        return STTS22H_NOT_INIT;
+    if (!isValid(bus, index))
+        return STTS22H_WRONG_DATA;
+
+    bus->settings[index] = controlReg;
+    bus->requests[index] |= STTS22H_BUS_SETTING;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Queue reading of the status and temperature registers values
+ * @param bus is the bus scheduler data structure
+ * @param index is the sensor index
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Bus_measure(STTS22H_Bus_Def *bus, uint8_t index) {
+    if (!isInit(bus))
+        return STTS22H_NOT_INIT;
+    if (!isValid(bus, index))
+        return STTS22H_WRONG_DATA;
+
+    bus->requests[index] |= STTS22H_BUS_MEASURE;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Queue reading of the status and temperature registers values for all registered sensors
+ * @param bus is the bus scheduler data structure
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Bus_measureAll(STTS22H_Bus_Def *bus) {
+    if (!isInit(bus))
+        return STTS22H_NOT_INIT;
+
+    for (uint8_t i = 0; i < getNumber(bus); ++i)
+        bus->requests[i] |= STTS22H_BUS_MEASURE;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Set the time source of the deadlines
+ * @param bus is the bus scheduler data structure
+ * @param getTime is the function, that returns current time (us)
+ */
+void STTS22H_Bus_setTimeSource(STTS22H_Bus_Def *bus, STTS22H_GetTime_Def getTime) {
+    bus->getTime = getTime;
+}
+
+/**
+ * @brief Set the priority of the sensor requests (the active transaction is always finished first)
+ * @param bus is the bus scheduler data structure
+ * @param index is the sensor index
+ * @param priority is the priority (0 - default, the higher value is serviced first)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Bus_setPriority(STTS22H_Bus_Def *bus, uint8_t index, uint8_t priority) {
+    if (!isInit(bus))
+        return STTS22H_NOT_INIT;
+    if (!isValid(bus, index))
+        return STTS22H_WRONG_DATA;
+
+    bus->priorities[index] = priority;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Queue reading of the status and temperature registers values, that should be finished before the deadline
+ * (the requests with the same priority are serviced in order of the deadlines)
+ * @param bus is the bus scheduler data structure
+ * @param index is the sensor index
+ * @param timeout is the deadline (us, from current time)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Bus_measureBefore(STTS22H_Bus_Def *bus, uint8_t index, uint32_t timeout) {
+    if (!isInit(bus))
+        return STTS22H_NOT_INIT;
+    if (!isValid(bus, index) || bus->getTime == NULL)
+        return STTS22H_WRONG_DATA;
+
+    uint32_t deadline = bus->getTime() + timeout;
+    // the queued measurement keeps the earlier deadline
+    if (!bus->isDeadline[index] || (int32_t) (deadline - bus->deadlines[index]) < 0)
+        bus->deadlines[index] = deadline;
+    bus->isDeadline[index] = true;
+    bus->requests[index] |= STTS22H_BUS_MEASURE;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Set the callback of the missed deadlines
+ * @param bus is the bus scheduler data structure
+ * @param onMissed is the callback function (NULL - STTS22H_Bus_getMissed is used)
+ */
+void STTS22H_Bus_setMissedCallback(STTS22H_Bus_Def *bus, STTS22H_BusMissed_Def onMissed) {
+    bus->onMissed = onMissed;
+}
+
+/**
+ * @brief Get the number of the measurements, that have been finished after their deadlines
+ * @param bus is the bus scheduler data structure
+ * @param index is the sensor index
+ * @return number of the missed deadlines
+ */
+uint32_t STTS22H_Bus_getMissed(const STTS22H_Bus_Def *bus, uint8_t index) {
+    if (!isInit(bus) || !isValid(bus, index))
+        return 0;
+
+    return bus->missed[index];
+}
+
+/**
+ * @brief Start the synchronized snapshot: the one-shot conversions of all sensors are started back to back,
+ * then all values are read after the conversion time (the sensors should be in power-down mode,
+ * they don't support the SMBus general call, so every sensor is started by its own write)
+ * @param bus is the bus scheduler data structure
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Bus_snapshot(STTS22H_Bus_Def *bus) {
+    if (!isInit(bus))
+        return STTS22H_NOT_INIT;
+    if (bus->getTime == NULL || bus->number == 0)
+        return STTS22H_WRONG_DATA;
+    if (bus->snapshotStep != STTS22H_SNAPSHOT_IDLE && bus->snapshotStep != STTS22H_SNAPSHOT_READY)
+        return STTS22H_BUSY;
+
+    bus->snapshot.valid = 0;
+    bus->snapshot.skew = 0;
+    bus->snapshotTime = bus->getTime();
+    for (uint8_t i = 0; i < getNumber(bus); ++i)
+        bus->requests[i] |= STTS22H_BUS_TRIGGER;
+    bus->snapshotStep = STTS22H_SNAPSHOT_TRIGGER;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Check, that the snapshot has been finished
+ * @param bus is the bus scheduler data structure
+ * @return True - the snapshot is ready, otherwise - False
+ */
+bool STTS22H_Bus_isSnapshotReady(const STTS22H_Bus_Def *bus) {
+    return isInit(bus) && bus->snapshotStep == STTS22H_SNAPSHOT_READY;
+}
+
+/**
+ * @brief Take the finished snapshot
+ * @param bus is the bus scheduler data structure
+ * @param out is the output snapshot
+ * @return STTS22H_Errors values (STTS22H_BUSY - the snapshot isn't finished)
+ */
+int STTS22H_Bus_getSnapshot(STTS22H_Bus_Def *bus, STTS22H_Snapshot_Def *out) {
+    if (!isInit(bus))
+        return STTS22H_NOT_INIT;
+    if (out == NULL || bus->snapshotStep == STTS22H_SNAPSHOT_IDLE)
+        return STTS22H_WRONG_DATA;
+    if (bus->snapshotStep != STTS22H_SNAPSHOT_READY)
+        return STTS22H_BUSY;
+
+    *out = bus->snapshot;
+    bus->snapshotStep = STTS22H_SNAPSHOT_IDLE;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Start discovery of the sensors: the "WHOAMI" register of every possible address is read once,
+ * the found sensors are configured between the other readings, then the absent sensors are removed
+ * (the sensors are registered in order of STTS22H_Addresses values, the result - STTS22H_Bus_getPresence)
+ * @param bus is the bus scheduler data structure (there should be no registered sensors)
+ * @param sensors is the array of STTS22H_BUS_ADDRESSES data structures (they are initialized)
+ * @param config is the configuration of the found sensors, it should exist during discovery (NULL - not configured)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Bus_discover(STTS22H_Bus_Def *bus, STTS22H_Def *sensors, const STTS22H_BusConfig_Def *config) {
+    static const uint8_t ADDRESSES[STTS22H_BUS_ADDRESSES] = {
+            STTS22H_ADDRESS_0, STTS22H_ADDRESS_1, STTS22H_ADDRESS_2, STTS22H_ADDRESS_3
+    };
+
+    if (!isInit(bus))
+        return STTS22H_NOT_INIT;
+    if (sensors == NULL || bus->number != 0 || STTS22H_BUS_MAX_SENSORS < STTS22H_BUS_ADDRESSES)
+        return STTS22H_WRONG_DATA;
+
+    for (uint8_t i = 0; i < STTS22H_BUS_ADDRESSES; ++i) {
+        int result = STTS22H_init(&sensors[i], bus->i2c, STTS22H_ADDRESS(ADDRESSES[i]));
+        if (result == STTS22H_SUCCESS)
+            result = STTS22H_Bus_addSensor(bus, &sensors[i]);
+        if (result != STTS22H_SUCCESS) {
+            bus->number = 0;
+            bus->current = 0;
+            return result;
+        }
+    }
+
+    for (uint8_t i = 0; i < STTS22H_BUS_ADDRESSES; ++i)
+        bus->requests[i] = STTS22H_BUS_CHECK_CONNECTION;
+    bus->presence = 0;
+    bus->config = config;
+    bus->isDiscovery = true;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Get the result of discovery
+ * @param bus is the bus scheduler data structure
+ * @return bit mask of the found addresses (bit 0 - STTS22H_ADDRESS_0, ...)
+ */
+uint8_t STTS22H_Bus_getPresence(const STTS22H_Bus_Def *bus) {
+    return bus->presence;
+}
+
+/**
+ * @brief Get the last measured values of all registered sensors (in order of registration)
+ * @param bus is the bus scheduler data structure
+ * @param out is the output arrays (every array has STTS22H_BUS_MAX_SENSORS elements, NULL - the array isn't required)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Bus_readBatch(const STTS22H_Bus_Def *bus, STTS22H_Batch_Def *out) {
+    if (!isInit(bus))
+        return STTS22H_NOT_INIT;
+
+    return STTS22H_readBatch((const STTS22H_Def *const *) bus->sensors, bus->number, out);
+}
+
+/**
+ * @brief Check, that the bus scheduler has an active transaction, queued requests, the snapshot or discovery
+ * (the own work of the sensors, e.g. the periodic modes, is reported by STTS22H_Bus_isPending)
+ * @param bus is the bus scheduler data structure
+ * @return True - the scheduler is busy, otherwise - False
+ */
+bool STTS22H_Bus_isBusy(const STTS22H_Bus_Def *bus) {
+    if (!isInit(bus))
+        return false;
+    if (isValid(bus, bus->current))
+        return true;
+    if (bus->snapshotStep != STTS22H_SNAPSHOT_IDLE && bus->snapshotStep != STTS22H_SNAPSHOT_READY)
+        return true;
+    if (bus->isDiscovery)
+        return true;
+
+    for (uint8_t i = 0; i < getNumber(bus); ++i) {
+        if (bus->requests[i] != 0)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Check, that a registered sensor has its own work for STTS22H_Bus_update
+ * (events, periodic modes, recovery, unwritten settings)
+ * @param bus is the bus scheduler data structure
+ * @return True - STTS22H_Bus_update should be called, otherwise - False
+ */
+bool STTS22H_Bus_isPending(const STTS22H_Bus_Def *bus) {
+    if (!isInit(bus))
+        return false;
+
+    for (uint8_t i = 0; i < getNumber(bus); ++i) {
+        if (STTS22H_isPending(bus->sensors[i]))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Check the deadline of the finished measurement
+ * @param bus is the bus scheduler data structure
+ * @param index is the sensor index
+ * @param isSuccess is a flag (False - there is no measured value, the deadline is always missed)
+ */
+static void checkDeadline(STTS22H_Bus_Def *bus, uint8_t index, bool isSuccess) {
+    if (!bus->isDeadline[index] || bus->getTime == NULL)
+        return;
+
+    bus->isDeadline[index] = false;
+    uint32_t lateness = bus->getTime() - bus->deadlines[index];
+    if ((int32_t) lateness <= 0) {
+        if (isSuccess)
+            return;
+        lateness = 0; // the deadline hasn't been reached yet
+    }
+
+    bus->missed[index]++;
+    if (bus->onMissed != NULL)
+        bus->onMissed(bus, index, lateness);
+}
+
+/**
+ * @brief Start the next queued request of the temperature sensor
+ * @param bus is the bus scheduler data structure
+ * @param index is the sensor index
+ * @return True - an asynchronous transaction has been started, otherwise - False
+ */
+static bool startRequest(STTS22H_Bus_Def *bus, uint8_t index) {
+    STTS22H_Def *stts = bus->sensors[index];
+    uint8_t *requests = &bus->requests[index];
+    int result;
+
+    if (STTS22H_isBusy(stts))
+        return false;
+
+    if (STTS22H_isPending(stts)) {
+        // events, periodic modes and recovery are started by the driver itself
+        STTS22H_update(stts);
+        if (STTS22H_isBusy(stts)) {
+            bus->active = 0;
+            return true;
+        }
+    }
+
+    if (*requests & STTS22H_BUS_TRIGGER) {
+        STTS22H_Control_Def control = stts->settings;
+        control.fields.freerun = 0; // power-down after the conversion
+        control.fields.low_odr_start = 0;
+        control.fields.one_shot = 1;
+
+        result = STTS22H_settingAsync(stts, control.full);
+        if (result != STTS22H_BUSY)
+            *requests &= (uint8_t) ~STTS22H_BUS_TRIGGER;
+        if (result == STTS22H_SUCCESS && STTS22H_isBusy(stts)) {
+            bus->active = STTS22H_BUS_TRIGGER;
+            return true;
+        }
+    }
+
+    if (*requests & STTS22H_BUS_SNAPSHOT) {
+        result = STTS22H_measure(stts);
+        if (result != STTS22H_BUSY)
+            *requests &= (uint8_t) ~STTS22H_BUS_SNAPSHOT;
+        if (result == STTS22H_SUCCESS) {
+            bus->active = STTS22H_BUS_SNAPSHOT;
+            return true;
+        }
+    }
+
+    if (*requests & STTS22H_BUS_CONFIGURE) {
+        const STTS22H_BusConfig_Def *config = bus->config;
+        result = STTS22H_configureAsync(stts, config->controlReg, config->minTemp, config->maxTemp,
+                                        config->isSetLimits);
+        if (result != STTS22H_BUSY)
+            *requests &= (uint8_t) ~STTS22H_BUS_CONFIGURE;
+        if (result == STTS22H_SUCCESS && STTS22H_isBusy(stts)) {
+            bus->active = STTS22H_BUS_CONFIGURE;
+            return true;
+        }
+    }
+
+    if (*requests & STTS22H_BUS_CHECK_CONNECTION) {
+        result = STTS22H_checkConnection(stts);
+        if (result != STTS22H_BUSY)
+            *requests &= (uint8_t) ~STTS22H_BUS_CHECK_CONNECTION;
+        if (result == STTS22H_SUCCESS) {
+            bus->active = STTS22H_BUS_CHECK_CONNECTION;
+            return true;
+        }
+    }
+
+    if (*requests & STTS22H_BUS_SETTING) {
+        result = STTS22H_settingAsync(stts, bus->settings[index]);
+        if (result != STTS22H_BUSY)
+            *requests &= (uint8_t) ~STTS22H_BUS_SETTING;
+        // the write is skipped, if the sensor has the same value
+        if (result == STTS22H_SUCCESS && STTS22H_isBusy(stts)) {
+            bus->active = STTS22H_BUS_SETTING;
+            return true;
+        }
+    }
+
+    if (*requests & STTS22H_BUS_MEASURE) {
+        result = STTS22H_measure(stts);
+        if (result != STTS22H_BUSY)
+            *requests &= (uint8_t) ~STTS22H_BUS_MEASURE;
+        // the measurement can't be done (e.g. STTS22H_NOT_CONNECTED), its deadline is missed
+        if (result != STTS22H_BUSY && result != STTS22H_SUCCESS)
+            checkDeadline(bus, index, false);
+        if (result == STTS22H_SUCCESS) {
+            bus->active = STTS22H_BUS_MEASURE;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Handle the finished snapshot transaction
+ * @param bus is the bus scheduler data structure
+ * @param index is the sensor index
+ */
+static void finishSnapshot(STTS22H_Bus_Def *bus, uint8_t index) {
+    const STTS22H_Def *stts = bus->sensors[index];
+    STTS22H_Snapshot_Def *snapshot = &bus->snapshot;
+    bool isSuccess = (STTS22H_getResult(stts) == STTS22H_SUCCESS);
+
+    if (bus->active == STTS22H_BUS_TRIGGER) {
+        if (STTS22H_getSettingResult(stts) != STTS22H_SUCCESS)
+            return;
+
+        // the conversion is started by the end of the write transaction
+        uint32_t now = bus->getTime();
+        uint32_t endTime = now + STTS22H_getConversionTime(stts);
+        if (snapshot->valid == 0) {
+            snapshot->timestamp = now;
+            bus->snapshotTime = endTime;
+        } else if ((int32_t) (endTime - bus->snapshotTime) > 0) {
+            bus->snapshotTime = endTime;
+        }
+
+        snapshot->offsets[index] = now - snapshot->timestamp;
+        snapshot->skew = snapshot->offsets[index]; // the sensors are started one by one
+        snapshot->valid |= (uint8_t) (1U << index);
+    } else if (isSuccess && !stts->status.fields.busy) {
+        snapshot->temp[index] = stts->temp;
+        snapshot->status[index] = stts->status.full;
+    } else {
+        snapshot->valid &= (uint8_t) ~(1U << index);
+    }
+}
+
+/**
+ * @brief Move the snapshot to the next step (all transactions of the current step have been finished)
+ * @param bus is the bus scheduler data structure
+ */
+static void processSnapshot(STTS22H_Bus_Def *bus) {
+    uint8_t request = (bus->snapshotStep == STTS22H_SNAPSHOT_TRIGGER) ? STTS22H_BUS_TRIGGER : STTS22H_BUS_SNAPSHOT;
+    for (uint8_t i = 0; i < getNumber(bus); ++i) {
+        if (bus->requests[i] & request)
+            return;
+    }
+
+    switch (bus->snapshotStep) {
+        case STTS22H_SNAPSHOT_TRIGGER:
+            bus->snapshotStep = (bus->snapshot.valid != 0) ? STTS22H_SNAPSHOT_CONVERSION : STTS22H_SNAPSHOT_READY;
+            break;
+        case STTS22H_SNAPSHOT_CONVERSION:
+            if ((int32_t) (bus->getTime() - bus->snapshotTime) < 0)
+                break;
+            // the values of the started sensors are read in one pass
+            for (uint8_t i = 0; i < getNumber(bus); ++i) {
+                if (bus->snapshot.valid & (1U << i))
+                    bus->requests[i] |= STTS22H_BUS_SNAPSHOT;
+            }
+            bus->snapshotStep = STTS22H_SNAPSHOT_READ;
+            break;
+        case STTS22H_SNAPSHOT_READ:
+            bus->snapshotStep = STTS22H_SNAPSHOT_READY;
+            break;
+    }
+}
+
+/**
+ * @brief Remove the sensor (the bus is free)
+ * @param bus is the bus scheduler data structure
+ * @param index is the sensor index
+ */
+static void removeSensor(STTS22H_Bus_Def *bus, uint8_t index) {
+    for (uint8_t i = index + 1; i < getNumber(bus); ++i) {
+        bus->requests[i - 1] = bus->requests[i];
+        bus->settings[i - 1] = bus->settings[i];
+        bus->priorities[i - 1] = bus->priorities[i];
+        bus->isDeadline[i - 1] = bus->isDeadline[i];
+        bus->deadlines[i - 1] = bus->deadlines[i];
+        bus->missed[i - 1] = bus->missed[i];
+        bus->sensors[i - 1] = bus->sensors[i];
+    }
+    bus->number--;
+    bus->current = bus->number;
+    bus->last = 0;
+}
+
+/**
+ * @brief Handle the finished connection check of discovery, remove the absent sensors at the end
+ * @param bus is the bus scheduler data structure
+ * @param index is the sensor index (bus->number - there is no finished transaction)
+ */
+static void processDiscovery(STTS22H_Bus_Def *bus, uint8_t index) {
+    if (isValid(bus, index) && bus->active == STTS22H_BUS_CHECK_CONNECTION &&
+        STTS22H_isConnected(bus->sensors[index])) {
+        bus->presence |= (uint8_t) (1U << index);
+        if (bus->config != NULL)
+            bus->requests[index] |= STTS22H_BUS_CONFIGURE;
+    }
+
+    for (uint8_t i = 0; i < getNumber(bus); ++i) {
+        if (bus->requests[i] & (STTS22H_BUS_CHECK_CONNECTION | STTS22H_BUS_CONFIGURE))
+            return;
+    }
+
+    // the indexes are equal to the address indexes until the end of discovery
+    for (uint8_t i = STTS22H_BUS_ADDRESSES; i > 0; --i) {
+        if (!(bus->presence & (1U << (i - 1))))
+            removeSensor(bus, i - 1);
+    }
+    bus->isDiscovery = false;
+}
+
+/**
+ * @brief Check, that the sensor has queued requests or its own work
+ * @param bus is the bus scheduler data structure
+ * @param index is the sensor index
+ * @return True - the sensor is waiting for the bus, otherwise - False
+ */
+static bool isWaiting(const STTS22H_Bus_Def *bus, uint8_t index) {
+    return bus->requests[index] != 0 || STTS22H_isPending(bus->sensors[index]);
+}
+
+/**
+ * @brief Compare the sensors, that are waiting for the bus: ALERT events, the snapshot, priority, the earliest deadline
+ * @param bus is the bus scheduler data structure
+ * @param index is the sensor index
+ * @param other is the index of the other sensor
+ * @return True - the sensor should be serviced before the other sensor, otherwise - False
+ */
+static bool isBefore(const STTS22H_Bus_Def *bus, uint8_t index, uint8_t other) {
+    bool isAlert = STTS22H_isAlertPending(bus->sensors[index]);
+    bool isOtherAlert = STTS22H_isAlertPending(bus->sensors[other]);
+    if (isAlert != isOtherAlert)
+        return isAlert;
+
+    // the snapshot transactions are executed back to back
+    bool isSnapshot = (bus->requests[index] & (STTS22H_BUS_TRIGGER | STTS22H_BUS_SNAPSHOT)) != 0;
+    bool isOtherSnapshot = (bus->requests[other] & (STTS22H_BUS_TRIGGER | STTS22H_BUS_SNAPSHOT)) != 0;
+    if (isSnapshot != isOtherSnapshot)
+        return isSnapshot;
+    if (bus->priorities[index] != bus->priorities[other])
+        return bus->priorities[index] > bus->priorities[other];
+
+    bool isDeadline = bus->isDeadline[index] && (bus->requests[index] & STTS22H_BUS_MEASURE);
+    bool isOtherDeadline = bus->isDeadline[other] && (bus->requests[other] & STTS22H_BUS_MEASURE);
+    if (isDeadline && isOtherDeadline)
+        return (int32_t) (bus->deadlines[index] - bus->deadlines[other]) < 0;
+    return isDeadline && !isOtherDeadline;
+}
+
+/**
+ * @brief Update current state of the bus scheduler (queued requests are executed back to back:
+ * ALERT events and the snapshot first, then in order of the priorities and deadlines, the equal requests are serviced round-robin)
+ * @param bus is the bus scheduler data structure
+ */
+void STTS22H_Bus_update(STTS22H_Bus_Def *bus) {
+    if (!isInit(bus))
+        return;
+
+    if (isValid(bus, bus->current)) {
+        STTS22H_Def *stts = bus->sensors[bus->current];
+        STTS22H_update(stts);
+        if (STTS22H_isBusy(stts))
+            return;
+
+        if (bus->active == STTS22H_BUS_MEASURE)
+            checkDeadline(bus, bus->current, STTS22H_getResult(stts) == STTS22H_SUCCESS);
+        else if (bus->active == STTS22H_BUS_TRIGGER || bus->active == STTS22H_BUS_SNAPSHOT)
+            finishSnapshot(bus, bus->current);
+        bus->last = bus->current;
+        bus->current = bus->number;
+        if (bus->isDiscovery)
+            processDiscovery(bus, bus->last);
+    } else if (bus->isDiscovery) {
+        processDiscovery(bus, bus->number);
+    }
+
+    if (bus->snapshotStep != STTS22H_SNAPSHOT_IDLE && bus->snapshotStep != STTS22H_SNAPSHOT_READY)
+        processSnapshot(bus);
+
+    uint8_t number = getNumber(bus);
+    uint32_t tried = 0; // sensors, that haven't started a transaction
+    for (uint8_t n = 0; n < number; ++n) {
+        uint8_t best = number;
+        for (uint8_t i = 1; i <= number; ++i) {
+            uint8_t index = (uint8_t) ((bus->last + i) % number);
+            if ((tried & (1UL << index)) || !isWaiting(bus, index))
+                continue;
+            if (best == number || isBefore(bus, index, best))
+                best = index;
+        }
+        if (best == number)
+            return;
+
+        if (startRequest(bus, best)) {
+            bus->current = best;
+            return;
+        }
+        tried |= 1UL << best;
+    }
+}
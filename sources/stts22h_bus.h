@@ -0,0 +1,127 @@
+#ifndef STTS22H_BUS_H
+#define STTS22H_BUS_H
+
+#include "stts22h.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef STTS22H_BUS_MAX_SENSORS
+#define STTS22H_BUS_MAX_SENSORS 4 // up to 4 I2C/SMBus slave addresses
+#endif
+
+enum STTS22H_BusRequests {
+    STTS22H_BUS_CHECK_CONNECTION = 0x01,
+    STTS22H_BUS_SETTING = 0x02,
+    STTS22H_BUS_MEASURE = 0x04,
+    STTS22H_BUS_TRIGGER = 0x08, // the one-shot conversion of the snapshot
+    STTS22H_BUS_SNAPSHOT = 0x10, // reading of the snapshot values
+    STTS22H_BUS_CONFIGURE = 0x20, // the configuration of the discovered sensor
+};
+
+#define STTS22H_BUS_ADDRESSES 4 // number of the possible device addresses (STTS22H_Addresses values)
+
+typedef struct {
+    uint8_t controlReg; // control register value (STTS22H_ControlReg_Def.full)
+    bool isSetLimits; // True - set the thresholds and turn ON interrupts, False - turn OFF interrupts
+    int16_t minTemp; // 0.01C, low threshold
+    int16_t maxTemp; // 0.01C, high threshold
+} STTS22H_BusConfig_Def;
+
+enum STTS22H_BusSnapshotSteps {
+    STTS22H_SNAPSHOT_IDLE = 0,
+    STTS22H_SNAPSHOT_TRIGGER, // the one-shot conversions are being started
+    STTS22H_SNAPSHOT_CONVERSION, // waiting for the end of the conversions
+    STTS22H_SNAPSHOT_READ, // the values are being read
+    STTS22H_SNAPSHOT_READY,
+};
+
+typedef struct {
+    uint32_t timestamp; // us, the first conversion start
+    uint32_t skew; // us, between the first and the last conversion start
+    uint8_t valid; // bit mask of the sensors, that have the measured values
+    int16_t temp[STTS22H_BUS_MAX_SENSORS]; // 0.01C
+    uint8_t status[STTS22H_BUS_MAX_SENSORS];
+    uint32_t offsets[STTS22H_BUS_MAX_SENSORS]; // us, conversion start of the sensor after the timestamp
+} STTS22H_Snapshot_Def;
+
+struct STTS22H_Bus_Data;
+
+// the measurement has been finished after its deadline or it has been failed (lateness, us, 0 - before the deadline)
+typedef void (*STTS22H_BusMissed_Def)(struct STTS22H_Bus_Data *bus, uint8_t index, uint32_t lateness);
+
+typedef struct STTS22H_Bus_Data {
+    bool isInit;
+
+    uint8_t number; // number of the registered sensors
+    uint8_t current; // index of the sensor, that owns the bus (number - the bus is free)
+    uint8_t last; // index of the last serviced sensor (round-robin)
+
+    uint8_t requests[STTS22H_BUS_MAX_SENSORS]; // STTS22H_BusRequests flags
+    uint8_t settings[STTS22H_BUS_MAX_SENSORS]; // queued control register values
+    uint8_t priorities[STTS22H_BUS_MAX_SENSORS]; // the higher value is serviced first (ALERT events are always first)
+    bool isDeadline[STTS22H_BUS_MAX_SENSORS]; // the queued measurement has the deadline
+    uint32_t deadlines[STTS22H_BUS_MAX_SENSORS]; // us, time, when the queued measurement should be finished
+    uint32_t missed[STTS22H_BUS_MAX_SENSORS]; // number of the missed deadlines
+    STTS22H_Def *sensors[STTS22H_BUS_MAX_SENSORS];
+    uint8_t active; // STTS22H_BusRequests flag of the current transaction (0 - the own transaction of the driver)
+
+    STTS22H_GetTime_Def getTime; // NULL - the deadlines and the snapshots aren't used
+    uint8_t snapshotStep; // STTS22H_BusSnapshotSteps values
+    uint32_t snapshotTime; // us, the end of the snapshot conversions
+    STTS22H_Snapshot_Def snapshot;
+
+    bool isDiscovery; // the sensors are being discovered
+    uint8_t presence; // bit mask of the found addresses (bit 0 - STTS22H_ADDRESS_0, ...)
+    const STTS22H_BusConfig_Def *config; // configuration of the discovered sensors (NULL - not configured)
+    STTS22H_BusMissed_Def onMissed;
+
+    I2CDef *i2c;
+} STTS22H_Bus_Def;
+
+int STTS22H_Bus_init(STTS22H_Bus_Def *bus, I2CDef *i2c);
+
+int STTS22H_Bus_addSensor(STTS22H_Bus_Def *bus, STTS22H_Def *stts);
+
+int STTS22H_Bus_checkConnection(STTS22H_Bus_Def *bus, uint8_t index);
+
+int STTS22H_Bus_setting(STTS22H_Bus_Def *bus, uint8_t index, uint8_t controlReg);
+
+int STTS22H_Bus_measure(STTS22H_Bus_Def *bus, uint8_t index);
+
+int STTS22H_Bus_measureAll(STTS22H_Bus_Def *bus);
+
+void STTS22H_Bus_setTimeSource(STTS22H_Bus_Def *bus, STTS22H_GetTime_Def getTime);
+
+int STTS22H_Bus_setPriority(STTS22H_Bus_Def *bus, uint8_t index, uint8_t priority);
+
+int STTS22H_Bus_measureBefore(STTS22H_Bus_Def *bus, uint8_t index, uint32_t timeout);
+
+void STTS22H_Bus_setMissedCallback(STTS22H_Bus_Def *bus, STTS22H_BusMissed_Def onMissed);
+
+uint32_t STTS22H_Bus_getMissed(const STTS22H_Bus_Def *bus, uint8_t index);
+
+int STTS22H_Bus_snapshot(STTS22H_Bus_Def *bus);
+
+bool STTS22H_Bus_isSnapshotReady(const STTS22H_Bus_Def *bus);
+
+int STTS22H_Bus_getSnapshot(STTS22H_Bus_Def *bus, STTS22H_Snapshot_Def *out);
+
+int STTS22H_Bus_discover(STTS22H_Bus_Def *bus, STTS22H_Def *sensors, const STTS22H_BusConfig_Def *config);
+
+uint8_t STTS22H_Bus_getPresence(const STTS22H_Bus_Def *bus);
+
+int STTS22H_Bus_readBatch(const STTS22H_Bus_Def *bus, STTS22H_Batch_Def *out);
+
+bool STTS22H_Bus_isBusy(const STTS22H_Bus_Def *bus);
+
+bool STTS22H_Bus_isPending(const STTS22H_Bus_Def *bus);
+
+void STTS22H_Bus_update(STTS22H_Bus_Def *bus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STTS22H_BUS_H
@@ -0,0 +1,75 @@
+#include "stts22h_fifo.h"
+
+static const unsigned MASK = STTS22H_FIFO_SIZE - 1;
+
+/**
+ * @brief The ring buffer initialization (it must be called before the buffer is attached to the sensor)
+ * @param fifo is the ring buffer data structure
+ */
+void STTS22H_Fifo_init(STTS22H_Fifo_Def *fifo) {
+    atomic_init(&fifo->head, 0);
+    atomic_init(&fifo->tail, 0);
+    fifo->dropped = 0;
+}
+
+/**
+ * @brief Put a new sample to the ring buffer (producer side)
+ * @param fifo is the ring buffer data structure
+ * @param sample is the new sample
+ * @return True - sample has been stored, otherwise (buffer is full) - False
+ */
+bool STTS22H_Fifo_push(STTS22H_Fifo_Def *fifo, const STTS22H_Sample_Def *sample) {
+    unsigned head = atomic_load_explicit(&fifo->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+
+    if ((head - tail) >= STTS22H_FIFO_SIZE) {
+        fifo->dropped++;
+        return false;
+    }
+
+    fifo->buffer[head & MASK] = *sample;
+    atomic_store_explicit(&fifo->head, head + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Take the stored samples from the ring buffer (consumer side)
+ * @param fifo is the ring buffer data structure
+ * @param samples is the output array
+ * @param number is the output array size
+ * @return number of the copied samples
+ */
+size_t STTS22H_Fifo_pop(STTS22H_Fifo_Def *fifo, STTS22H_Sample_Def *samples, size_t number) {
+    unsigned tail = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&fifo->head, memory_order_acquire);
+
+    size_t count = head - tail;
+    if (count > number)
+        count = number;
+
+    for (size_t i = 0; i < count; ++i)
+        samples[i] = fifo->buffer[(tail + i) & MASK];
+
+    atomic_store_explicit(&fifo->tail, tail + (unsigned) count, memory_order_release);
+    return count;
+}
+
+/**
+ * @brief Get the number of the stored samples
+ * @param fifo is the ring buffer data structure
+ * @return number of samples
+ */
+size_t STTS22H_Fifo_getCount(const STTS22H_Fifo_Def *fifo) {
+    unsigned head = atomic_load_explicit(&fifo->head, memory_order_acquire);
+    unsigned tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+    return head - tail;
+}
+
+/**
+ * @brief Get the number of the lost samples (the ring buffer was full)
+ * @param fifo is the ring buffer data structure
+ * @return number of samples
+ */
+uint32_t STTS22H_Fifo_getDropped(const STTS22H_Fifo_Def *fifo) {
+    return fifo->dropped;
+}
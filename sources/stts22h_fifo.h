@@ -0,0 +1,53 @@
+#ifndef STTS22H_FIFO_H
+#define STTS22H_FIFO_H
+
+#include <stddef.h>
+#ifdef __cplusplus
+#include <atomic>
+using std::atomic_uint; // the same layout as atomic_uint of C11
+#else
+#include <stdatomic.h>
+#endif
+
+#include "stts22h.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef STTS22H_FIFO_SIZE
+#define STTS22H_FIFO_SIZE 32 // samples, power of two
+#endif
+
+#if (STTS22H_FIFO_SIZE < 2) || ((STTS22H_FIFO_SIZE & (STTS22H_FIFO_SIZE - 1)) != 0)
+#error "STTS22H_FIFO_SIZE must be a power of two"
+#endif
+
+/**
+ * Single-producer/single-consumer ring buffer:
+ * the producer (STTS22H_update/STTS22H_transferComplete) writes only "head" and "dropped",
+ * the consumer writes only "tail"
+ */
+typedef struct STTS22H_Fifo_Data {
+    atomic_uint head;
+    atomic_uint tail;
+    uint32_t dropped; // number of lost samples (buffer is full)
+
+    STTS22H_Sample_Def buffer[STTS22H_FIFO_SIZE];
+} STTS22H_Fifo_Def;
+
+void STTS22H_Fifo_init(STTS22H_Fifo_Def *fifo);
+
+bool STTS22H_Fifo_push(STTS22H_Fifo_Def *fifo, const STTS22H_Sample_Def *sample);
+
+size_t STTS22H_Fifo_pop(STTS22H_Fifo_Def *fifo, STTS22H_Sample_Def *samples, size_t number);
+
+size_t STTS22H_Fifo_getCount(const STTS22H_Fifo_Def *fifo);
+
+uint32_t STTS22H_Fifo_getDropped(const STTS22H_Fifo_Def *fifo);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STTS22H_FIFO_H
@@ -0,0 +1,117 @@
+#include "stts22h_filter.h"
+
+/**
+ * @brief The filter initialization (integer-only processing, one value per call)
+ * @param filter is the filter data structure
+ * @param type is the filter type (STTS22H_FilterTypes values)
+ * @param taps is the moving average window (1...STTS22H_FILTER_MAX_TAPS) or the exponential filter shift (0...15)
+ * @param decimation is the decimation factor (N:1, N > 0)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Filter_init(STTS22H_Filter_Def *filter, uint8_t type, uint8_t taps, uint16_t decimation) {
+    if (filter == NULL || decimation == 0)
+        return STTS22H_WRONG_DATA;
+
+    switch (type) {
+        case STTS22H_FILTER_NONE:
+            break;
+        case STTS22H_FILTER_MOVING_AVERAGE:
+            if (taps == 0 || taps > STTS22H_FILTER_MAX_TAPS)
+                return STTS22H_WRONG_DATA;
+            break;
+        case STTS22H_FILTER_EXPONENTIAL:
+            if (taps > 15)
+                return STTS22H_WRONG_DATA;
+            break;
+        default:
+            return STTS22H_WRONG_DATA;
+    }
+
+    filter->type = type;
+    filter->taps = taps;
+    filter->decimation = decimation;
+    STTS22H_Filter_reset(filter);
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Forget all previous values
+ * @param filter is the filter data structure
+ */
+void STTS22H_Filter_reset(STTS22H_Filter_Def *filter) {
+    filter->counter = 0;
+    filter->index = 0;
+    filter->number = 0;
+    filter->state = 0;
+    filter->isReady = false;
+}
+
+/**
+ * @brief Calculate the next filtered value
+ * @param filter is the filter data structure
+ * @param value is the new value (0.01C)
+ * @return filtered value (0.01C)
+ */
+static int16_t calculate(STTS22H_Filter_Def *filter, int16_t value) {
+    switch (filter->type) {
+        case STTS22H_FILTER_MOVING_AVERAGE:
+            if (filter->number < filter->taps)
+                filter->number++;
+            else
+                filter->state -= filter->history[filter->index];
+
+            filter->history[filter->index] = value;
+            filter->state += value;
+            filter->index = (uint8_t) ((filter->index + 1) % filter->taps);
+            return (int16_t) (filter->state / filter->number);
+        case STTS22H_FILTER_EXPONENTIAL: {
+            int32_t scale = (int32_t) 1 << filter->taps;
+            if (filter->number == 0) {
+                filter->number = 1;
+                filter->state = (int32_t) value * scale;
+            } else {
+                filter->state += value - filter->state / scale;
+            }
+            return (int16_t) (filter->state / scale);
+        }
+        default:
+            return value;
+    }
+}
+
+/**
+ * @brief Put a new value to the filter
+ * @param filter is the filter data structure
+ * @param value is the new value (0.01C)
+ * @return True - there is a new output value (after the decimation), otherwise - False
+ */
+bool STTS22H_Filter_push(STTS22H_Filter_Def *filter, int16_t value) {
+    int16_t result = calculate(filter, value);
+
+    if (++filter->counter < filter->decimation)
+        return false;
+
+    filter->counter = 0;
+    filter->output = result;
+    filter->isReady = true;
+    return true;
+}
+
+/**
+ * @brief Check, that the filter has a new output value
+ * @param filter is the filter data structure
+ * @return True - there is a new value, otherwise - False
+ */
+bool STTS22H_Filter_isReady(const STTS22H_Filter_Def *filter) {
+    return filter->isReady;
+}
+
+/**
+ * @brief Take the last output value
+ * @param filter is the filter data structure
+ * @return filtered value (0.01C)
+ */
+int16_t STTS22H_Filter_getOutput(STTS22H_Filter_Def *filter) {
+    filter->isReady = false;
+    return filter->output;
+}
@@ -0,0 +1,49 @@
+#ifndef STTS22H_FILTER_H
+#define STTS22H_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stts22h.h"
+
+#ifndef STTS22H_FILTER_MAX_TAPS
+#define STTS22H_FILTER_MAX_TAPS 16 // maximum window of the moving average
+#endif
+
+enum STTS22H_FilterTypes {
+    STTS22H_FILTER_NONE = 0, // only the decimation
+    STTS22H_FILTER_MOVING_AVERAGE,
+    STTS22H_FILTER_EXPONENTIAL, // y += (x - y) / 2^shift
+};
+
+typedef struct STTS22H_Filter_Data {
+    uint8_t type; // STTS22H_FilterTypes values
+    uint8_t taps; // moving average window or exponential filter shift
+    uint16_t decimation; // every N-th filtered value is the output (N:1)
+
+    uint16_t counter; // decimation counter
+    uint8_t index; // next position in the history
+    uint8_t number; // number of values in the history
+    int32_t state; // moving average sum or exponential filter value (scaled by 2^shift)
+    int16_t history[STTS22H_FILTER_MAX_TAPS];
+
+    int16_t output; // 0.01C
+    bool isReady; // a new output value
+} STTS22H_Filter_Def;
+
+int STTS22H_Filter_init(STTS22H_Filter_Def *filter, uint8_t type, uint8_t taps, uint16_t decimation);
+
+void STTS22H_Filter_reset(STTS22H_Filter_Def *filter);
+
+bool STTS22H_Filter_push(STTS22H_Filter_Def *filter, int16_t value);
+
+bool STTS22H_Filter_isReady(const STTS22H_Filter_Def *filter);
+
+int16_t STTS22H_Filter_getOutput(STTS22H_Filter_Def *filter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STTS22H_FILTER_H
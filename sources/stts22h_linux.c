@@ -0,0 +1,517 @@
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L // shm_open, clock_nanosleep
+#endif
+
+#include "stts22h_linux.h"
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+/**
+ * @brief Get current time (it is the time source of the driver instances)
+ * @return time (us, CLOCK_MONOTONIC)
+ */
+uint32_t STTS22H_Linux_getTime(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t) ((uint64_t) now.tv_sec * 1000000U + (uint64_t) now.tv_nsec / 1000U);
+}
+
+/**
+ * @brief Execute the messages by one I2C_RDWR ioctl
+ * @param dev is the Linux bus data structure
+ * @param msgs is the messages
+ * @param number is the number of messages
+ * @return I2C_Errors values
+ */
+static int execute(STTS22H_Linux_Def *dev, struct i2c_msg *msgs, uint32_t number) {
+    struct i2c_rdwr_ioctl_data data = {.msgs = msgs, .nmsgs = number};
+    dev->transfers++;
+    return (ioctl(dev->fd, I2C_RDWR, &data) < 0) ? I2C_FAILED : I2C_SUCCESS;
+}
+
+/**
+ * @brief Execute the messages of one sensor at once, the sensor is excluded from the combined transfer
+ * until it answers
+ * @param i2c is the channel of the sensor
+ * @param msgs is the messages
+ * @param number is the number of messages
+ * @return I2C_Errors values
+ */
+static int executeAlone(I2CDef *i2c, struct i2c_msg *msgs, uint32_t number) {
+    STTS22H_Linux_Def *dev = i2c->bus;
+    uint8_t mask = (uint8_t) (1U << (i2c - dev->channels));
+
+    int result = execute(dev, msgs, number);
+    i2c->isFailed = (result != I2C_SUCCESS);
+    if (i2c->isFailed)
+        dev->absent |= mask;
+    else
+        dev->absent &= (uint8_t) ~mask;
+    return result;
+}
+
+/**
+ * @brief Write data at once (i2c-dev transport)
+ * @param i2c is the channel of the sensor
+ * @param devAddr is the device address
+ * @param data is the data
+ * @param dataSize is the number of bytes
+ * @param isBlocking is a flag (True - the result of the transfer is returned)
+ * @return I2C_Errors values
+ */
+static int linuxWrite(I2CDef *i2c, uint8_t devAddr, const uint8_t *data, uint8_t dataSize, bool isBlocking) {
+    struct i2c_msg msg = {.addr = devAddr, .flags = 0, .len = dataSize, .buf = (uint8_t *) data};
+    int result = executeAlone(i2c, &msg, 1);
+    // the non-blocking transfer is finished, its result is taken by STTS22H_update (isFailed)
+    return isBlocking ? result : I2C_SUCCESS;
+}
+
+/**
+ * @brief Read data into the buffer of the driver at once (i2c-dev transport)
+ * @param i2c is the channel of the sensor
+ * @param devAddr is the device address
+ * @param regAddr is the first register address (it has been written by the previous transfer)
+ * @param data is the destination buffer
+ * @param dataSize is the number of bytes
+ * @return I2C_Errors values
+ */
+static int linuxReadInto(I2CDef *i2c, uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint8_t dataSize) {
+    (void) regAddr;
+    struct i2c_msg msg = {.addr = devAddr, .flags = I2C_M_RD, .len = dataSize, .buf = data};
+    executeAlone(i2c, &msg, 1);
+    return I2C_SUCCESS;
+}
+
+/**
+ * @brief Queue the combined write-then-read transfer, it is executed by STTS22H_Linux_transfer
+ * (the transfer of the excluded sensor is executed at once)
+ * @param i2c is the channel of the sensor
+ * @param devAddr is the device address
+ * @param regAddr is the pointer to the first register address
+ * @param data is the destination buffer
+ * @param dataSize is the number of bytes
+ * @return I2C_Errors values
+ */
+static int linuxWriteRead(I2CDef *i2c, uint8_t devAddr, const uint8_t *regAddr, uint8_t *data, uint8_t dataSize) {
+    if (i2c->bus->absent & (1U << (i2c - i2c->bus->channels))) {
+        struct i2c_msg msgs[2] = {
+                {.addr = devAddr, .flags = 0, .len = sizeof(uint8_t), .buf = (uint8_t *) regAddr},
+                {.addr = devAddr, .flags = I2C_M_RD, .len = dataSize, .buf = data}
+        };
+        executeAlone(i2c, msgs, 2);
+        return I2C_SUCCESS;
+    }
+
+    i2c->regAddr = regAddr;
+    i2c->data = data;
+    i2c->dataSize = dataSize;
+    i2c->isFailed = false;
+    i2c->isQueued = true;
+    return I2C_SUCCESS;
+}
+
+/**
+ * @brief Check, that the transfer is queued (i2c-dev transport)
+ * @param i2c is the channel of the sensor
+ * @return True - the transfer waits for STTS22H_Linux_transfer, otherwise - False
+ */
+static bool linuxIsBusy(I2CDef *i2c) {
+    return i2c->isQueued;
+}
+
+/**
+ * @brief Check, that the last transfer has been failed (i2c-dev transport)
+ * @param i2c is the channel of the sensor
+ * @return True - the sensor hasn't answered, otherwise - False
+ */
+static bool linuxIsFailed(I2CDef *i2c) {
+    return i2c->isFailed;
+}
+
+const STTS22H_Transport_Def STTS22H_LINUX_TRANSPORT = {
+        .write = linuxWrite,
+        .read = NULL,
+        .getReceivedData = NULL,
+        .isBusy = linuxIsBusy,
+        .isFailed = linuxIsFailed,
+        .writeRead = linuxWriteRead,
+        .readInto = linuxReadInto
+};
+
+/**
+ * @brief Open the i2c-dev bus (it should support the combined I2C_RDWR transfers)
+ * @param dev is the Linux bus data structure
+ * @param path is the device file (e.g. "/dev/i2c-1")
+ * @return STTS22H_Errors values (STTS22H_FAILED - see errno)
+ */
+int STTS22H_Linux_open(STTS22H_Linux_Def *dev, const char *path) {
+    if (dev == NULL || path == NULL)
+        return STTS22H_WRONG_DATA;
+
+    memset(dev, 0, sizeof(STTS22H_Linux_Def));
+    dev->fd = open(path, O_RDWR);
+    if (dev->fd < 0)
+        return STTS22H_FAILED;
+
+    unsigned long funcs = 0;
+    if (ioctl(dev->fd, I2C_FUNCS, &funcs) < 0 || !(funcs & I2C_FUNC_I2C)) {
+        close(dev->fd);
+        dev->fd = -1;
+        return STTS22H_FAILED;
+    }
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Close the bus and unmap the ring buffer (the shared memory object isn't removed)
+ * @param dev is the Linux bus data structure
+ */
+void STTS22H_Linux_close(STTS22H_Linux_Def *dev) {
+    if (dev->ring != NULL)
+        munmap(dev->ring, dev->ringSize);
+    if (dev->fd >= 0)
+        close(dev->fd);
+
+    dev->ring = NULL;
+    dev->fd = -1;
+}
+
+/**
+ * @brief Register the temperature sensor (the driver instance with the i2c-dev transport)
+ * @param dev is the Linux bus data structure
+ * @param addr is the 7-bit device address (STTS22H_Addresses values)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Linux_addSensor(STTS22H_Linux_Def *dev, uint8_t addr) {
+    if (dev->fd < 0)
+        return STTS22H_NOT_INIT;
+    if (dev->number >= STTS22H_LINUX_MAX_SENSORS || addr == 0 || addr > 0x7F)
+        return STTS22H_WRONG_DATA;
+
+    I2CDef *channel = &dev->channels[dev->number];
+    STTS22H_Def *stts = &dev->sensors[dev->number];
+    memset(channel, 0, sizeof(I2CDef));
+    channel->bus = dev;
+    channel->devAddr = addr;
+
+    int result = STTS22H_init(stts, channel, addr);
+    if (result == STTS22H_SUCCESS)
+        result = STTS22H_setTransport(stts, &STTS22H_LINUX_TRANSPORT);
+    if (result != STTS22H_SUCCESS)
+        return result;
+
+    STTS22H_setTimeSource(stts, STTS22H_Linux_getTime);
+    dev->number++;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Turn ON freerun mode of all sensors (the control register is programmed by the streaming setup
+ * of the driver, then the sensors are read by STTS22H_Linux_read)
+ * @param dev is the Linux bus data structure
+ * @param avg is the output data rate (STTS22H_AVG values)
+ * @return STTS22H_Errors values (STTS22H_FAILED - a sensor hasn't answered, STTS22H_NOT_CONNECTED - a sensor is degraded)
+ */
+int STTS22H_Linux_configure(STTS22H_Linux_Def *dev, uint8_t avg) {
+    if (dev->fd < 0)
+        return STTS22H_NOT_INIT;
+    if (dev->number == 0 || avg > STTS22H_AVG_200Hz)
+        return STTS22H_WRONG_DATA;
+
+    int result = STTS22H_SUCCESS;
+    for (uint8_t i = 0; i < dev->number; ++i) {
+        STTS22H_Def *stts = &dev->sensors[i];
+        // the degraded sensor isn't written by the driver until its connection is restored
+        if (STTS22H_isDegraded(stts)) {
+            result = STTS22H_NOT_CONNECTED;
+            continue;
+        }
+        if (STTS22H_startStreaming(stts, avg) != STTS22H_SUCCESS)
+            return STTS22H_WRONG_DATA;
+
+        // the write is executed at once, the next update finishes it
+        do {
+            STTS22H_update(stts);
+        } while (STTS22H_getSettingResult(stts) == STTS22H_BUSY);
+        STTS22H_stopStreaming(stts); // the sensor stays in freerun mode
+
+        if (STTS22H_isDegraded(stts))
+            result = STTS22H_NOT_CONNECTED;
+        else if (STTS22H_getSettingResult(stts) != STTS22H_SUCCESS && result == STTS22H_SUCCESS)
+            result = STTS22H_FAILED;
+    }
+
+    dev->period = STTS22H_getConversionTime(&dev->sensors[0]); // the output data period of freerun mode
+    return result;
+}
+
+/**
+ * @brief Execute the queued transfers of all sensors by one I2C_RDWR ioctl
+ * (if a sensor doesn't answer, the sensors are read one by one and the silent ones are excluded)
+ * @param dev is the Linux bus data structure
+ * @return STTS22H_Errors values (STTS22H_FAILED - all sensors haven't answered)
+ */
+int STTS22H_Linux_transfer(STTS22H_Linux_Def *dev) {
+    if (dev->fd < 0)
+        return STTS22H_NOT_INIT;
+
+    struct i2c_msg msgs[2 * STTS22H_LINUX_MAX_SENSORS];
+    I2CDef *queued[STTS22H_LINUX_MAX_SENSORS];
+    uint8_t number = 0;
+    for (uint8_t i = 0; i < dev->number; ++i) {
+        I2CDef *channel = &dev->channels[i];
+        if (!channel->isQueued)
+            continue;
+
+        msgs[2 * number].addr = channel->devAddr;
+        msgs[2 * number].flags = 0;
+        msgs[2 * number].len = sizeof(uint8_t);
+        msgs[2 * number].buf = (uint8_t *) channel->regAddr;
+        msgs[2 * number + 1].addr = channel->devAddr;
+        msgs[2 * number + 1].flags = I2C_M_RD;
+        msgs[2 * number + 1].len = channel->dataSize;
+        msgs[2 * number + 1].buf = channel->data;
+        queued[number++] = channel;
+    }
+    if (number == 0)
+        return STTS22H_SUCCESS;
+
+    // the transfer is stopped by the first NACK, then every sensor is checked separately once
+    bool isAll = (execute(dev, msgs, 2U * number) == I2C_SUCCESS);
+    uint8_t answered = 0;
+    for (uint8_t i = 0; i < number; ++i) {
+        if (isAll)
+            queued[i]->isFailed = false;
+        else
+            executeAlone(queued[i], &msgs[2 * i], 2);
+        queued[i]->isQueued = false;
+        answered += !queued[i]->isFailed;
+    }
+
+    return (answered != 0) ? STTS22H_SUCCESS : STTS22H_FAILED;
+}
+
+/**
+ * @brief Publish the record into the ring buffer
+ * @param ring is the ring buffer
+ * @param record is the record
+ */
+static void publish(STTS22H_LinuxRing_Def *ring, const STTS22H_LinuxRecord_Def *record) {
+    unsigned head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    // the slot is claimed before it is overwritten, the readers check the claim after the copying
+    atomic_store_explicit(&ring->claim, head + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    ring->records[head & (ring->capacity - 1)] = *record;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+/**
+ * @brief Read the status and temperature registers values of all sensors by one ioctl (reading pass)
+ * @param dev is the Linux bus data structure
+ * @return STTS22H_Errors values (STTS22H_FAILED - all sensors haven't answered)
+ */
+int STTS22H_Linux_read(STTS22H_Linux_Def *dev) {
+    if (dev->fd < 0)
+        return STTS22H_NOT_INIT;
+    if (dev->number == 0)
+        return STTS22H_WRONG_DATA;
+
+    // the degraded sensors are skipped by the driver, their connection is checked by STTS22H_update
+    for (uint8_t i = 0; i < dev->number; ++i)
+        STTS22H_measure(&dev->sensors[i]);
+    STTS22H_Linux_transfer(dev);
+
+    uint32_t timestamp = STTS22H_Linux_getTime();
+    uint8_t answered = 0;
+    dev->sequence++;
+    for (uint8_t i = 0; i < dev->number; ++i) {
+        STTS22H_Def *stts = &dev->sensors[i];
+        STTS22H_update(stts);
+
+        STTS22H_Sample_Def sample;
+        bool isValid = STTS22H_getSample(stts, &sample);
+        answered += isValid;
+        if (dev->ring != NULL) {
+            STTS22H_LinuxRecord_Def record = {
+                    .timestamp = isValid ? sample.timestamp : timestamp,
+                    .sequence = dev->sequence,
+                    .temp = isValid ? sample.raw : 0,
+                    .index = i,
+                    .status = isValid ? sample.status.full : 0,
+                    .isValid = isValid
+            };
+            publish(dev->ring, &record);
+        }
+    }
+
+    return (answered != 0) ? STTS22H_SUCCESS : STTS22H_FAILED;
+}
+
+/**
+ * @brief Read all sensors with the output data rate of STTS22H_Linux_configure (daemon mode)
+ * @param dev is the Linux bus data structure
+ * @param isRunning is a flag (False - stop, e.g. by the signal handler)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Linux_run(STTS22H_Linux_Def *dev, const volatile bool *isRunning) {
+    if (dev->fd < 0)
+        return STTS22H_NOT_INIT;
+    if (isRunning == NULL || dev->number == 0 || dev->period == 0)
+        return STTS22H_WRONG_DATA;
+
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while (*isRunning) {
+        next.tv_nsec += (long) dev->period * 1000L;
+        while (next.tv_nsec >= 1000000000L) {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+
+        int result = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        if (result != 0 && result != EINTR)
+            return STTS22H_FAILED;
+        if (result == 0)
+            STTS22H_Linux_read(dev);
+    }
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Get the size of the ring buffer
+ * @param capacity is the number of records
+ * @return size (bytes)
+ */
+static size_t getRingSize(uint32_t capacity) {
+    return sizeof(STTS22H_LinuxRing_Def) + (size_t) capacity * sizeof(STTS22H_LinuxRecord_Def);
+}
+
+/**
+ * @brief Create the shared memory ring buffer, every reading pass is published into it
+ * @param dev is the Linux bus data structure
+ * @param name is the shared memory object name (e.g. "/stts22h")
+ * @param capacity is the number of records (power of two)
+ * @return STTS22H_Errors values (STTS22H_FAILED - see errno)
+ */
+int STTS22H_Linux_createRing(STTS22H_Linux_Def *dev, const char *name, uint32_t capacity) {
+    if (dev->fd < 0)
+        return STTS22H_NOT_INIT;
+    if (name == NULL || dev->ring != NULL || capacity < 2 || (capacity & (capacity - 1)) != 0)
+        return STTS22H_WRONG_DATA;
+
+    size_t size = getRingSize(capacity);
+    int fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0)
+        return STTS22H_FAILED;
+    if (ftruncate(fd, (off_t) size) < 0) {
+        close(fd);
+        return STTS22H_FAILED;
+    }
+
+    void *memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+        return STTS22H_FAILED;
+
+    STTS22H_LinuxRing_Def *ring = memory;
+    ring->capacity = capacity;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->claim, 0);
+    atomic_thread_fence(memory_order_release);
+    ring->magic = STTS22H_LINUX_RING_MAGIC;
+
+    dev->ring = ring;
+    dev->ringSize = size;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Map the shared memory ring buffer (read-only), the reading starts from the next record
+ * @param reader is the consumer data structure
+ * @param name is the shared memory object name
+ * @return STTS22H_Errors values (STTS22H_FAILED - see errno, STTS22H_NOT_INIT - the ring isn't created)
+ */
+int STTS22H_Linux_openRing(STTS22H_LinuxReader_Def *reader, const char *name) {
+    if (reader == NULL || name == NULL)
+        return STTS22H_WRONG_DATA;
+
+    reader->ring = NULL;
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0)
+        return STTS22H_FAILED;
+
+    STTS22H_LinuxRing_Def header;
+    ssize_t length = read(fd, &header, sizeof(header));
+    if (length != (ssize_t) sizeof(header) || header.magic != STTS22H_LINUX_RING_MAGIC) {
+        close(fd);
+        return STTS22H_NOT_INIT;
+    }
+
+    size_t size = getRingSize(header.capacity);
+    const void *memory = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+        return STTS22H_FAILED;
+
+    reader->ring = memory;
+    reader->ringSize = size;
+    reader->tail = atomic_load_explicit(&reader->ring->head, memory_order_acquire);
+    reader->lost = 0;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Copy the new records (the records, that are read in place, should be checked by "claim" the same way)
+ * @param reader is the consumer data structure
+ * @param records is the output records
+ * @param number is the maximum number of records
+ * @return number of the copied records
+ */
+size_t STTS22H_Linux_readRing(STTS22H_LinuxReader_Def *reader, STTS22H_LinuxRecord_Def *records, size_t number) {
+    const STTS22H_LinuxRing_Def *ring = reader->ring;
+    STTS22H_LinuxRing_Def *shared = (STTS22H_LinuxRing_Def *) ring;
+    size_t count = 0;
+
+    while (count < number) {
+        unsigned head = atomic_load_explicit(&shared->head, memory_order_acquire);
+        if (head == reader->tail)
+            break;
+
+        records[count] = ring->records[reader->tail & (ring->capacity - 1)];
+        // the record could be overwritten during the copying (sequence lock): the slot of the record "claim - 1"
+        // is being written, the older records of the same slot aren't valid
+        atomic_thread_fence(memory_order_acquire);
+        unsigned claim = atomic_load_explicit(&shared->claim, memory_order_relaxed);
+        if (claim - reader->tail > ring->capacity) {
+            reader->lost += claim - ring->capacity - reader->tail;
+            reader->tail = claim - ring->capacity; // the oldest record, that isn't overwritten
+            continue;
+        }
+
+        reader->tail++;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Unmap the ring buffer
+ * @param reader is the consumer data structure
+ */
+void STTS22H_Linux_closeRing(STTS22H_LinuxReader_Def *reader) {
+    if (reader->ring != NULL)
+        munmap((void *) reader->ring, reader->ringSize);
+    reader->ring = NULL;
+}
+
+#endif // __linux__
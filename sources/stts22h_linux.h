@@ -0,0 +1,130 @@
+#ifndef STTS22H_LINUX_H
+#define STTS22H_LINUX_H
+
+#ifdef __linux__
+
+#include <stddef.h>
+#ifdef __cplusplus
+#include <atomic>
+using std::atomic_uint; // the same layout as atomic_uint of C11
+#else
+#include <stdatomic.h>
+#endif
+
+#include "stts22h.h"
+
+#if STTS22H_USE_I2C_DRIVER
+#error "the i2c-dev transport defines I2CDef itself, it requires STTS22H_USE_I2C_DRIVER = 0"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Linux userspace acquisition (i2c-dev): the sensors are the STTS22H_Def instances of the driver with the i2c-dev
+ * transport, their combined write-then-read transfers are queued and all of them are executed by one I2C_RDWR ioctl
+ * with the output data rate. The sensors, that don't answer, are excluded from the combined transfer (their transfers
+ * are executed one by one, e.g. the connection checks of the driver). The samples are published into the shared
+ * memory ring buffer (shm_open), that can be mapped by several consumers.
+ */
+
+#ifndef STTS22H_LINUX_MAX_SENSORS
+#define STTS22H_LINUX_MAX_SENSORS 4 // sensors of one bus (up to 4 device addresses)
+#endif
+
+#define STTS22H_LINUX_RING_MAGIC 0x53545452UL // "STTR"
+
+struct STTS22H_Linux_Data;
+
+/**
+ * Channel of one sensor on the i2c-dev bus (I2CDef of the driver instance)
+ */
+struct I2CDef {
+    struct STTS22H_Linux_Data *bus;
+    uint8_t devAddr; // 7-bit device address
+    const uint8_t *regAddr; // register address of the queued transfer
+    uint8_t *data; // destination buffer of the queued transfer
+    uint8_t dataSize; // bytes
+    bool isQueued; // the transfer waits for STTS22H_Linux_transfer
+    bool isFailed; // the last transfer hasn't been acknowledged
+};
+
+extern const STTS22H_Transport_Def STTS22H_LINUX_TRANSPORT;
+
+typedef struct {
+    uint32_t timestamp; // us, CLOCK_MONOTONIC
+    uint16_t sequence; // number of the reading pass
+    int16_t temp; // 0.01C
+    uint8_t index; // order of STTS22H_Linux_addSensor calls
+    uint8_t status; // STTS22H_Status_Def.full
+    uint8_t isValid; // 0 - the sensor hasn't answered
+    uint8_t reserved;
+} STTS22H_LinuxRecord_Def;
+
+/**
+ * Shared memory ring buffer: one producer, any number of consumers (every consumer has its own position),
+ * the oldest records are overwritten (the writer claims the slot before the record is written, the reader checks
+ * the claim after the copying)
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t capacity; // records, power of two
+    atomic_uint head; // number of the written records
+    atomic_uint claim; // number of the started records (head + 1 - the record "head" is being written)
+    STTS22H_LinuxRecord_Def records[];
+} STTS22H_LinuxRing_Def;
+
+typedef struct STTS22H_Linux_Data {
+    int fd; // i2c-dev file descriptor (-1 - closed)
+
+    uint8_t number; // number of the registered sensors
+    uint8_t absent; // bit mask of the sensors, that are excluded from the combined transfer
+    uint16_t sequence; // number of the reading passes
+    uint32_t period; // us, output data rate of freerun mode
+    uint32_t transfers; // number of the I2C_RDWR ioctls
+    I2CDef channels[STTS22H_LINUX_MAX_SENSORS];
+    STTS22H_Def sensors[STTS22H_LINUX_MAX_SENSORS]; // the driver instances (callbacks, filters can be attached)
+
+    STTS22H_LinuxRing_Def *ring; // NULL - the samples aren't published
+    size_t ringSize; // bytes
+} STTS22H_Linux_Def;
+
+typedef struct {
+    const STTS22H_LinuxRing_Def *ring;
+    size_t ringSize; // bytes
+    uint32_t tail; // number of the read records
+    uint32_t lost; // number of the overwritten records, that haven't been read
+} STTS22H_LinuxReader_Def;
+
+uint32_t STTS22H_Linux_getTime(void);
+
+int STTS22H_Linux_open(STTS22H_Linux_Def *dev, const char *path);
+
+void STTS22H_Linux_close(STTS22H_Linux_Def *dev);
+
+int STTS22H_Linux_addSensor(STTS22H_Linux_Def *dev, uint8_t addr);
+
+int STTS22H_Linux_configure(STTS22H_Linux_Def *dev, uint8_t avg);
+
+int STTS22H_Linux_transfer(STTS22H_Linux_Def *dev);
+
+int STTS22H_Linux_read(STTS22H_Linux_Def *dev);
+
+int STTS22H_Linux_run(STTS22H_Linux_Def *dev, const volatile bool *isRunning);
+
+int STTS22H_Linux_createRing(STTS22H_Linux_Def *dev, const char *name, uint32_t capacity);
+
+int STTS22H_Linux_openRing(STTS22H_LinuxReader_Def *reader, const char *name);
+
+size_t STTS22H_Linux_readRing(STTS22H_LinuxReader_Def *reader, STTS22H_LinuxRecord_Def *records, size_t number);
+
+void STTS22H_Linux_closeRing(STTS22H_LinuxReader_Def *reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __linux__
+
+#endif // STTS22H_LINUX_H
@@ -0,0 +1,219 @@
+#include "stts22h_log.h"
+
+static const uint8_t STATUS_MASK = 0x0F;
+static const uint8_t TAG_MASK = 0xF0;
+
+/**
+ * @brief The log encoder initialization
+ * @param encoder is the encoder data structure
+ * @param keyframeInterval is the number of samples between the keyframes (0 - only at the beginning of the page)
+ * @return STTS22H_Errors values
+ */
+int STTS22H_Log_initEncoder(STTS22H_LogEncoder_Def *encoder, uint16_t keyframeInterval) {
+    if (encoder == NULL)
+        return STTS22H_WRONG_DATA;
+
+    encoder->page = NULL;
+    encoder->size = 0;
+    encoder->length = 0;
+    encoder->keyframeInterval = keyframeInterval;
+    encoder->count = 0;
+    encoder->isStarted = false;
+    encoder->isFull = false;
+    encoder->dropped = 0;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Set a new page (the previous page is complete), the first sample is written as the keyframe
+ * @param encoder is the encoder data structure
+ * @param page is the page buffer
+ * @param size is the page size (bytes)
+ */
+void STTS22H_Log_setPage(STTS22H_LogEncoder_Def *encoder, uint8_t *page, uint16_t size) {
+    encoder->page = page;
+    encoder->size = (page != NULL) ? size : 0;
+    encoder->length = 0;
+    encoder->isStarted = false;
+    encoder->isFull = false;
+}
+
+/**
+ * @brief Write the value (little-endian)
+ * @param data is the output buffer
+ * @param value is the value
+ * @param size is the value size (bytes)
+ */
+static void writeValue(uint8_t *data, uint32_t value, uint8_t size) {
+    for (uint8_t i = 0; i < size; ++i)
+        data[i] = (uint8_t) (value >> (8 * i));
+}
+
+/**
+ * @brief Read the value (little-endian)
+ * @param data is the input buffer
+ * @param size is the value size (bytes)
+ * @return value
+ */
+static uint32_t readValue(const uint8_t *data, uint8_t size) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < size; ++i)
+        value |= (uint32_t) data[i] << (8 * i);
+    return value;
+}
+
+/**
+ * @brief Encode the sample
+ * @param encoder is the encoder data structure
+ * @param sample is the sample
+ * @param data is the output buffer (STTS22H_LOG_MAX_SAMPLE_SIZE bytes)
+ * @return number of bytes
+ */
+static uint8_t encodeSample(const STTS22H_LogEncoder_Def *encoder, const STTS22H_Sample_Def *sample, uint8_t *data) {
+    uint8_t status = sample->status.full & STATUS_MASK;
+    bool isKeyframe = !encoder->isStarted || (uint16_t) (encoder->sequence + 1) != sample->sequence ||
+                      (encoder->keyframeInterval != 0 && encoder->count >= encoder->keyframeInterval);
+
+    if (isKeyframe) {
+        data[0] = STTS22H_LOG_KEYFRAME | status;
+        writeValue(&data[1], sample->sequence, 2);
+        writeValue(&data[3], (uint16_t) sample->raw, 2);
+        writeValue(&data[5], sample->timestamp, 4);
+        return STTS22H_LOG_KEYFRAME_SIZE;
+    }
+
+    int32_t delta = (int32_t) sample->raw - encoder->last;
+    if (status == encoder->status && delta >= -64 && delta <= 63) {
+        data[0] = (uint8_t) (delta & 0x7F);
+        return 1;
+    }
+
+    // zigzag: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+    uint32_t value = (delta >= 0) ? (uint32_t) delta * 2 : (uint32_t) (-delta) * 2 - 1;
+    uint8_t size = 0;
+    data[size++] = STTS22H_LOG_CHANGE | status;
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        data[size++] = (value != 0) ? (byte | 0x80) : byte;
+    } while (value != 0);
+    return size;
+}
+
+/**
+ * @brief Put the sample into the current page
+ * @param encoder is the encoder data structure
+ * @param sample is the sample
+ * @return STTS22H_Errors values (STTS22H_BUSY - the page is full, a new page should be set)
+ */
+int STTS22H_Log_encode(STTS22H_LogEncoder_Def *encoder, const STTS22H_Sample_Def *sample) {
+    uint8_t data[STTS22H_LOG_MAX_SAMPLE_SIZE];
+    uint8_t size = encodeSample(encoder, sample, data);
+
+    if (encoder->page == NULL || encoder->length + size > encoder->size) {
+        encoder->isFull = true;
+        encoder->dropped++;
+        return STTS22H_BUSY;
+    }
+
+    for (uint8_t i = 0; i < size; ++i)
+        encoder->page[encoder->length + i] = data[i];
+    encoder->length += size;
+
+    encoder->count = ((data[0] & TAG_MASK) == STTS22H_LOG_KEYFRAME) ? 1 : encoder->count + 1;
+    encoder->isStarted = true;
+    encoder->last = sample->raw;
+    encoder->sequence = sample->sequence;
+    encoder->status = sample->status.full & STATUS_MASK;
+    return STTS22H_SUCCESS;
+}
+
+/**
+ * @brief Get the number of the written bytes of the current page
+ * @param encoder is the encoder data structure
+ * @return number of bytes
+ */
+uint16_t STTS22H_Log_getLength(const STTS22H_LogEncoder_Def *encoder) {
+    return encoder->length;
+}
+
+/**
+ * @brief Check, that the current page is full (the last sample hasn't been written)
+ * @param encoder is the encoder data structure
+ * @return True - the page is full, otherwise - False
+ */
+bool STTS22H_Log_isFull(const STTS22H_LogEncoder_Def *encoder) {
+    return encoder->isFull;
+}
+
+/**
+ * @brief The log decoder initialization
+ * @param decoder is the decoder data structure
+ * @param page is the page buffer
+ * @param length is the number of the written bytes
+ */
+void STTS22H_Log_initDecoder(STTS22H_LogDecoder_Def *decoder, const uint8_t *page, uint16_t length) {
+    decoder->page = page;
+    decoder->length = length;
+    decoder->position = 0;
+    decoder->isStarted = false;
+}
+
+/**
+ * @brief Get the next sample of the page
+ * @param decoder is the decoder data structure
+ * @param sample is the output sample (timestamp is 0, if the sample isn't the keyframe)
+ * @return STTS22H_Errors values (STTS22H_BUSY - the end of the page, STTS22H_WRONG_DATA - the page is damaged)
+ */
+int STTS22H_Log_decode(STTS22H_LogDecoder_Def *decoder, STTS22H_Sample_Def *sample) {
+    if (decoder->position >= decoder->length)
+        return STTS22H_BUSY;
+
+    const uint8_t *data = &decoder->page[decoder->position];
+    uint16_t available = decoder->length - decoder->position;
+    uint8_t tag = data[0];
+    uint16_t size = 1;
+    sample->timestamp = 0;
+
+    if ((tag & TAG_MASK) == STTS22H_LOG_KEYFRAME) {
+        if (available < STTS22H_LOG_KEYFRAME_SIZE)
+            return STTS22H_WRONG_DATA;
+
+        decoder->status = tag & STATUS_MASK;
+        decoder->sequence = (uint16_t) readValue(&data[1], 2);
+        decoder->last = (int16_t) readValue(&data[3], 2);
+        sample->timestamp = readValue(&data[5], 4);
+        decoder->isStarted = true;
+        size = STTS22H_LOG_KEYFRAME_SIZE;
+    } else if (!decoder->isStarted) {
+        return STTS22H_WRONG_DATA;
+    } else if (!(tag & 0x80)) {
+        int32_t delta = (tag & 0x40) ? (int32_t) tag - 0x80 : tag;
+        decoder->last = (int16_t) (decoder->last + delta);
+        decoder->sequence++;
+    } else if ((tag & TAG_MASK) == STTS22H_LOG_CHANGE) {
+        uint32_t value = 0;
+        uint8_t shift = 0;
+        uint8_t byte;
+        do {
+            if (size >= available || shift > 14)
+                return STTS22H_WRONG_DATA;
+            byte = data[size++];
+            value |= (uint32_t) (byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        int32_t delta = (value & 1) ? -(int32_t) ((value + 1) / 2) : (int32_t) (value / 2);
+        decoder->status = tag & STATUS_MASK;
+        decoder->last = (int16_t) (decoder->last + delta);
+        decoder->sequence++;
+    } else {
+        return STTS22H_WRONG_DATA;
+    }
+
+    decoder->position += size;
+    sample->raw = decoder->last;
+    sample->status.full = decoder->status;
+    sample->sequence = decoder->sequence;
+    return STTS22H_SUCCESS;
+}
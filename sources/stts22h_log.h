@@ -0,0 +1,72 @@
+#ifndef STTS22H_LOG_H
+#define STTS22H_LOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stts22h.h"
+
+/**
+ * Compact sample log (e.g. for the flash memory pages), every page starts with a keyframe:
+ *     0ddddddd                    - delta (-64...63), the same status, the next sequence number (1 byte)
+ *     1000ssss + varint(zigzag)   - any delta and a new status nibble, the next sequence number
+ *     1111ssss + seq + raw + time - keyframe (uint16_t, int16_t, uint32_t, little-endian, 9 bytes)
+ * Timestamps are stored only in the keyframes.
+ */
+
+enum STTS22H_LogTags {
+    STTS22H_LOG_DELTA = 0x00,
+    STTS22H_LOG_CHANGE = 0x80,
+    STTS22H_LOG_KEYFRAME = 0xF0,
+};
+
+#define STTS22H_LOG_KEYFRAME_SIZE 9 // bytes
+#define STTS22H_LOG_MAX_SAMPLE_SIZE STTS22H_LOG_KEYFRAME_SIZE
+
+typedef struct STTS22H_LogEncoder_Data {
+    uint8_t *page;
+    uint16_t size; // bytes
+    uint16_t length; // bytes, that have been written
+
+    uint16_t keyframeInterval; // samples between the keyframes (0 - only at the beginning of the page)
+    uint16_t count; // samples after the last keyframe
+    bool isStarted; // the page has the keyframe
+    bool isFull; // the last sample hasn't been written
+    uint32_t dropped; // number of the samples, that haven't been written
+
+    int16_t last; // 0.01C
+    uint16_t sequence;
+    uint8_t status;
+} STTS22H_LogEncoder_Def;
+
+typedef struct {
+    const uint8_t *page;
+    uint16_t length; // bytes
+    uint16_t position;
+
+    bool isStarted;
+    int16_t last; // 0.01C
+    uint16_t sequence;
+    uint8_t status;
+} STTS22H_LogDecoder_Def;
+
+int STTS22H_Log_initEncoder(STTS22H_LogEncoder_Def *encoder, uint16_t keyframeInterval);
+
+void STTS22H_Log_setPage(STTS22H_LogEncoder_Def *encoder, uint8_t *page, uint16_t size);
+
+int STTS22H_Log_encode(STTS22H_LogEncoder_Def *encoder, const STTS22H_Sample_Def *sample);
+
+uint16_t STTS22H_Log_getLength(const STTS22H_LogEncoder_Def *encoder);
+
+bool STTS22H_Log_isFull(const STTS22H_LogEncoder_Def *encoder);
+
+void STTS22H_Log_initDecoder(STTS22H_LogDecoder_Def *decoder, const uint8_t *page, uint16_t length);
+
+int STTS22H_Log_decode(STTS22H_LogDecoder_Def *decoder, STTS22H_Sample_Def *sample);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STTS22H_LOG_H
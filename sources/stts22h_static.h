@@ -0,0 +1,86 @@
+#ifndef STTS22H_STATIC_H
+#define STTS22H_STATIC_H
+
+#include "stts22h.h"
+
+#if !STTS22H_USE_I2C_DRIVER
+#error "the specialized driver calls the functions of i2c.h, it requires STTS22H_USE_I2C_DRIVER = 1"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Compile-time specialized driver of one sensor (fixed I2C interface and device address).
+ * There are no runtime checks and no pointer to the driver data, the measure/update path is inlined:
+ * the functions of i2c.h are called directly (STTS22H_USE_I2C_DRIVER = 1), not by the transport of STTS22H_Def.
+ * Usage (in one source file):
+ *     STTS22H_STATIC_DEFINE(tempSensor, &i2c1, 0x38)
+ *     tempSensor_measure(); ... tempSensor_update(); ... tempSensor_getTemp_cC();
+ * Optional features of the full driver are not included (use STTS22H_Def, if they are required).
+ */
+
+#define STTS22H_STATIC_DEFINE(name, bus, addr)                                                   \
+    static struct {                                                                              \
+        int16_t temp; /* 0.01C */                                                                \
+        uint8_t regAddr;                                                                         \
+        volatile uint8_t phase; /* STTS22H_Phases values */                                      \
+        STTS22H_Status_Def status;                                                               \
+    } name##_data = {.temp = -27315, .regAddr = STTS22H_STATUS_ADDR,                             \
+                     .phase = STTS22H_PHASE_IDLE, .status = {.full = 0}};                        \
+                                                                                                 \
+    /* read the status and temperature registers values (STTS22H_Errors values) */               \
+    static inline int name##_measure(void) {                                                     \
+        if (name##_data.phase != STTS22H_PHASE_IDLE)                                             \
+            return STTS22H_BUSY;                                                                 \
+                                                                                                 \
+        int result = I2C_writeData((bus), (addr), &name##_data.regAddr, sizeof(uint8_t), false); \
+        if (result == I2C_SUCCESS)                                                               \
+            name##_data.phase = STTS22H_PHASE_ADDRESS;                                           \
+        return result;                                                                           \
+    }                                                                                            \
+                                                                                                 \
+    /* update current state of the sensor */                                                     \
+    static inline void name##_update(void) {                                                     \
+        if (name##_data.phase == STTS22H_PHASE_IDLE)                                             \
+            return;                                                                              \
+        if (I2C_isReading((bus)) || I2C_isWriting((bus)))                                        \
+            return;                                                                              \
+                                                                                                 \
+        if (name##_data.phase == STTS22H_PHASE_READ) {                                           \
+            name##_data.phase = STTS22H_PHASE_IDLE;                                              \
+            if (!I2C_isFailed((bus))) {                                                          \
+                const uint8_t *data = (const uint8_t *) I2C_getReceivedData((bus));              \
+                name##_data.status.full = data[0];                                               \
+                if (!name##_data.status.fields.busy)                                             \
+                    name##_data.temp = STTS22H_calculateRaw(data[2], data[1]);                   \
+            }                                                                                    \
+        } else if (I2C_isFailed((bus))) {                                                        \
+            name##_data.phase = STTS22H_PHASE_IDLE; /* the address isn't acknowledged */         \
+        } else {                                                                                 \
+            if (I2C_readData((bus), (addr), 3) == I2C_SUCCESS)                                   \
+                name##_data.phase = STTS22H_PHASE_READ;                                          \
+            else                                                                                 \
+                name##_data.phase = STTS22H_PHASE_IDLE;                                          \
+        }                                                                                        \
+    }                                                                                            \
+                                                                                                 \
+    static inline bool name##_isBusy(void) {                                                     \
+        return name##_data.phase != STTS22H_PHASE_IDLE;                                          \
+    }                                                                                            \
+                                                                                                 \
+    /* the last measured temperature value (0.01 degrees Celsius) */                             \
+    static inline int16_t name##_getTemp_cC(void) {                                              \
+        return name##_data.temp;                                                                 \
+    }                                                                                            \
+                                                                                                 \
+    static inline STTS22H_Status_Def name##_getStatus(void) {                                    \
+        return name##_data.status;                                                               \
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STTS22H_STATIC_H
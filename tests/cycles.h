@@ -0,0 +1,26 @@
+#ifndef STTS22H_CYCLES_H
+#define STTS22H_CYCLES_H
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+/**
+ * @brief Read the cycle counter of the host (TSC on x86, otherwise nanoseconds of the monotonic clock)
+ * @return counter value
+ */
+static inline uint64_t STTS22H_getCycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+#endif
+}
+
+#endif // STTS22H_CYCLES_H
@@ -0,0 +1,426 @@
+#include <string.h>
+
+#include "i2c.h"
+
+// registers of the simulated STTS22H (Datasheet, DS12606, Rev7, Aug 2022, page 15)
+enum I2C_MockRegisters {
+    WHOAMI_REG = 0x01,
+    TEMP_H_LIMIT_REG,
+    TEMP_L_LIMIT_REG,
+    CTRL_REG,
+    STATUS_REG,
+    TEMP_L_OUT_REG,
+    TEMP_H_OUT_REG
+};
+
+enum I2C_MockBits {
+    CTRL_ONE_SHOT = 0x01,
+    CTRL_FREERUN = 0x04,
+    CTRL_IF_ADD_INC = 0x08,
+    CTRL_AVG_SHIFT = 4,
+    CTRL_LOW_ODR_START = 0x80,
+
+    STATUS_BUSY = 0x01,
+    STATUS_OVER_THH = 0x02,
+    STATUS_UNDER_THL = 0x04,
+};
+
+// the conversion lasts one output data period of the averaging, us
+static const uint32_t CONVERSION_TIME[] = {40000, 20000, 10000, 5000};
+static const uint32_t LOW_ODR_PERIOD = 1000000; // us
+
+static uint32_t now; // us, simulated time of all interfaces
+
+/**
+ * @brief Check, that the time has been reached
+ * @param time is the required time (us)
+ * @return True - the time has been reached, otherwise - False
+ */
+static bool isTimeReached(uint32_t time) {
+    return (int32_t) (now - time) >= 0;
+}
+
+/**
+ * @brief Check, that the interface has an active transfer
+ * @param i2c is the I2C interface data structure
+ * @return True - the transfer is in progress, otherwise - False
+ */
+static bool isBusy(const I2CDef *i2c) {
+    return (i2c->isReading || i2c->isWriting) && !isTimeReached(i2c->endTime);
+}
+
+/**
+ * @brief Get the output data period of the continuous mode
+ * @param dev is the simulated device
+ * @return period (us, 0 - the device is in power-down mode)
+ */
+static uint32_t getPeriod(const I2C_MockDevice_Def *dev) {
+    uint8_t ctrl = dev->regs[CTRL_REG];
+    if (ctrl & CTRL_LOW_ODR_START)
+        return LOW_ODR_PERIOD;
+    if (ctrl & CTRL_FREERUN)
+        return CONVERSION_TIME[(ctrl >> CTRL_AVG_SHIFT) & 0x03];
+    return 0;
+}
+
+/**
+ * @brief Compare the temperature with the thresholds (0 - the threshold is turned OFF)
+ * @param dev is the simulated device
+ */
+static void checkLimits(I2C_MockDevice_Def *dev) {
+    // value = (register - 63) * 0.64C
+    uint8_t high = dev->regs[TEMP_H_LIMIT_REG];
+    uint8_t low = dev->regs[TEMP_L_LIMIT_REG];
+    if (high != 0 && dev->temp > ((int32_t) high - 63) * 64)
+        dev->regs[STATUS_REG] |= STATUS_OVER_THH;
+    if (low != 0 && dev->temp < ((int32_t) low - 63) * 64)
+        dev->regs[STATUS_REG] |= STATUS_UNDER_THL;
+}
+
+/**
+ * @brief Finish the conversions, that have been finished before the current time
+ * @param dev is the simulated device
+ */
+static void processDevice(I2C_MockDevice_Def *dev) {
+    while (dev->isConverting && isTimeReached(dev->conversionEnd)) {
+        uint16_t raw = (uint16_t) dev->temp;
+        dev->regs[TEMP_L_OUT_REG] = (uint8_t) raw;
+        dev->regs[TEMP_H_OUT_REG] = (uint8_t) (raw >> 8);
+        dev->regs[STATUS_REG] &= (uint8_t) ~STATUS_BUSY;
+        dev->regs[CTRL_REG] &= (uint8_t) ~CTRL_ONE_SHOT;
+        checkLimits(dev);
+
+        uint32_t period = getPeriod(dev);
+        dev->isConverting = (period != 0);
+        dev->conversionEnd += period;
+    }
+}
+
+/**
+ * @brief Apply the written control register value
+ * @param dev is the simulated device
+ */
+static void writeControl(I2C_MockDevice_Def *dev) {
+    uint8_t ctrl = dev->regs[CTRL_REG];
+    uint32_t period = getPeriod(dev);
+
+    if (period != 0) {
+        if (!dev->isConverting) {
+            dev->isConverting = true;
+            dev->conversionEnd = now + period;
+        }
+    } else if (ctrl & CTRL_ONE_SHOT) {
+        dev->isConverting = true;
+        dev->conversionEnd = now + CONVERSION_TIME[(ctrl >> CTRL_AVG_SHIFT) & 0x03];
+        dev->regs[STATUS_REG] |= STATUS_BUSY;
+    } else {
+        dev->isConverting = false;
+    }
+}
+
+/**
+ * @brief Move the register address of the device to the next register (IF_ADD_INC) or stay at the same register
+ * @param dev is the simulated device
+ */
+static void nextRegister(I2C_MockDevice_Def *dev) {
+    if (dev->regs[CTRL_REG] & CTRL_IF_ADD_INC)
+        dev->pointer = (uint8_t) ((dev->pointer + 1) % I2C_MOCK_REGISTERS);
+}
+
+/**
+ * @brief Check, that the device acknowledges its address (the NACK counter is decremented)
+ * @param dev is the simulated device (NULL - there is no device)
+ * @return True - the address has been acknowledged, otherwise - False
+ */
+static bool isAcknowledged(I2C_MockDevice_Def *dev) {
+    if (dev == NULL || !dev->isPresent)
+        return false;
+    if (dev->nacks != 0) {
+        dev->nacks--;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Start the transfer (the bus is occupied until its end)
+ * @param i2c is the I2C interface data structure
+ * @param dataSize is the number of the transferred bytes (0 - only the device address has been transferred)
+ * @param isAck is a flag (False - the address hasn't been acknowledged)
+ */
+static void startTransfer(I2CDef *i2c, uint16_t dataSize, bool isAck) {
+    uint32_t duration = I2C_Mock_getTransferTime(i2c, dataSize);
+    i2c->endTime = now + duration;
+    i2c->isFailed = !isAck;
+
+    i2c->stats.transfers++;
+    i2c->stats.bytes += dataSize;
+    i2c->stats.busTime += duration;
+    if (!isAck)
+        i2c->stats.nacks++;
+}
+
+/**
+ * @brief Write data (the device receives the register address and the register values)
+ * @param i2c is the I2C interface data structure
+ * @param devAddr is the device address (7 bits)
+ * @param data is the data
+ * @param dataSize is the number of bytes
+ * @param isBlocking is a flag (True - the simulated time is advanced until the end of the transfer)
+ * @return I2C_Errors values
+ */
+int I2C_writeData(I2CDef *i2c, uint8_t devAddr, const void *data, uint16_t dataSize, bool isBlocking) {
+    if (i2c == NULL || data == NULL || dataSize == 0)
+        return I2C_FAILED;
+    if (isBusy(i2c))
+        return I2C_BUSY;
+
+    I2C_MockDevice_Def *dev = I2C_Mock_getDevice(i2c, devAddr);
+    bool isAck = isAcknowledged(dev);
+    startTransfer(i2c, isAck ? dataSize : 0, isAck);
+
+    if (isAck) {
+        const uint8_t *bytes = (const uint8_t *) data;
+        processDevice(dev);
+        dev->pointer = (uint8_t) (bytes[0] % I2C_MOCK_REGISTERS);
+        for (uint16_t i = 1; i < dataSize; ++i) {
+            uint8_t reg = dev->pointer;
+            if (reg != WHOAMI_REG && reg != STATUS_REG && reg != TEMP_L_OUT_REG && reg != TEMP_H_OUT_REG)
+                dev->regs[reg] = bytes[i];
+            if (reg == CTRL_REG)
+                writeControl(dev);
+            nextRegister(dev);
+        }
+    }
+
+    i2c->isReading = false;
+    i2c->isWriting = true;
+    if (isBlocking) {
+        I2C_Mock_advance(i2c, i2c->endTime - now);
+        return i2c->isFailed ? I2C_FAILED : I2C_SUCCESS;
+    }
+    return I2C_SUCCESS;
+}
+
+/**
+ * @brief Read the registers from the current register address of the device (the threshold bits are cleared by
+ * the STATUS reading)
+ * @param dev is the simulated device
+ * @param data is the destination buffer
+ * @param dataSize is the number of bytes
+ */
+static void readRegisters(I2C_MockDevice_Def *dev, uint8_t *data, uint16_t dataSize) {
+    processDevice(dev);
+    for (uint16_t i = 0; i < dataSize; ++i) {
+        uint8_t reg = dev->pointer;
+        data[i] = dev->regs[reg];
+        if (reg == STATUS_REG)
+            dev->regs[reg] &= (uint8_t) ~(STATUS_OVER_THH | STATUS_UNDER_THL);
+        nextRegister(dev);
+    }
+}
+
+/**
+ * @brief Start reading from the current register address of the device into the destination buffer
+ * @param i2c is the I2C interface data structure
+ * @param devAddr is the device address (7 bits)
+ * @param data is the destination buffer
+ * @param dataSize is the number of bytes
+ * @return I2C_Errors values
+ */
+static int startReading(I2CDef *i2c, uint8_t devAddr, uint8_t *data, uint16_t dataSize) {
+    if (isBusy(i2c))
+        return I2C_BUSY;
+
+    I2C_MockDevice_Def *dev = I2C_Mock_getDevice(i2c, devAddr);
+    bool isAck = isAcknowledged(dev);
+    startTransfer(i2c, isAck ? dataSize : 0, isAck);
+    if (isAck)
+        readRegisters(dev, data, dataSize);
+
+    i2c->isReading = true;
+    i2c->isWriting = false;
+    return I2C_SUCCESS;
+}
+
+/**
+ * @brief Start reading from the current register address of the device
+ * @param i2c is the I2C interface data structure
+ * @param devAddr is the device address (7 bits)
+ * @param dataSize is the number of bytes
+ * @return I2C_Errors values
+ */
+int I2C_readData(I2CDef *i2c, uint8_t devAddr, uint16_t dataSize) {
+    if (i2c == NULL || dataSize == 0 || dataSize > I2C_MOCK_BUFFER_SIZE)
+        return I2C_FAILED;
+    return startReading(i2c, devAddr, i2c->rxData, dataSize);
+}
+
+/**
+ * @brief Get the received data of the last reading
+ * @param i2c is the I2C interface data structure
+ * @return pointer to the received data
+ */
+const void *I2C_getReceivedData(const I2CDef *i2c) {
+    return i2c->rxData;
+}
+
+/**
+ * @brief Check, that the reading is in progress
+ * @param i2c is the I2C interface data structure
+ * @return True - the reading is in progress, otherwise - False
+ */
+bool I2C_isReading(const I2CDef *i2c) {
+    return i2c->isReading && isBusy(i2c);
+}
+
+/**
+ * @brief Check, that the writing is in progress
+ * @param i2c is the I2C interface data structure
+ * @return True - the writing is in progress, otherwise - False
+ */
+bool I2C_isWriting(const I2CDef *i2c) {
+    return i2c->isWriting && isBusy(i2c);
+}
+
+/**
+ * @brief Check, that the last transfer has been failed
+ * @param i2c is the I2C interface data structure
+ * @return True - the device address hasn't been acknowledged, otherwise - False
+ */
+bool I2C_isFailed(const I2CDef *i2c) {
+    return i2c->isFailed;
+}
+
+/**
+ * @brief Start the combined transfer: write the register address, repeated START and read the register values
+ * into the destination buffer (a DMA transfer, the buffer of the interface isn't used)
+ * @param i2c is the I2C interface data structure
+ * @param devAddr is the device address (7 bits)
+ * @param regAddr is the register address
+ * @param data is the destination buffer
+ * @param dataSize is the number of bytes
+ * @return I2C_Errors values
+ */
+int I2C_Mock_writeRead(I2CDef *i2c, uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t dataSize) {
+    if (i2c == NULL || data == NULL || dataSize == 0)
+        return I2C_FAILED;
+    if (isBusy(i2c))
+        return I2C_BUSY;
+
+    I2C_MockDevice_Def *dev = I2C_Mock_getDevice(i2c, devAddr);
+    bool isAck = isAcknowledged(dev);
+    // the repeated START and the device address take the time of one byte
+    startTransfer(i2c, isAck ? (uint16_t) (1 + dataSize) : 0, isAck);
+    if (isAck) {
+        uint32_t addressTime = I2C_Mock_getTransferTime(i2c, 1) - I2C_Mock_getTransferTime(i2c, 0);
+        i2c->endTime += addressTime;
+        i2c->stats.busTime += addressTime;
+
+        dev->pointer = (uint8_t) (regAddr % I2C_MOCK_REGISTERS);
+        readRegisters(dev, data, dataSize);
+    }
+
+    i2c->isReading = true;
+    i2c->isWriting = false;
+    return I2C_SUCCESS;
+}
+
+/**
+ * @brief Start reading from the current register address of the device into the destination buffer
+ * (a DMA transfer, the buffer of the interface isn't used)
+ * @param i2c is the I2C interface data structure
+ * @param devAddr is the device address (7 bits)
+ * @param data is the destination buffer
+ * @param dataSize is the number of bytes
+ * @return I2C_Errors values
+ */
+int I2C_Mock_readInto(I2CDef *i2c, uint8_t devAddr, uint8_t *data, uint16_t dataSize) {
+    if (i2c == NULL || data == NULL || dataSize == 0)
+        return I2C_FAILED;
+    return startReading(i2c, devAddr, data, dataSize);
+}
+
+/**
+ * @brief The simulated interface initialization (the devices are removed)
+ * @param i2c is the I2C interface data structure
+ * @param speed is the SCL frequency (Hz, I2C_MockSpeeds values)
+ * @param latency is the delay of every transfer start (us)
+ */
+void I2C_Mock_init(I2CDef *i2c, uint32_t speed, uint32_t latency) {
+    memset(i2c, 0, sizeof(I2CDef));
+    i2c->speed = speed;
+    i2c->latency = latency;
+}
+
+/**
+ * @brief Connect a simulated STTS22H to the interface (the registers have the reset values)
+ * @param i2c is the I2C interface data structure
+ * @param devAddr is the device address (7 bits)
+ * @param temp is the temperature value of the conversions (0.01 degrees Celsius)
+ * @return the simulated device (NULL - there is no free place)
+ */
+I2C_MockDevice_Def *I2C_Mock_addDevice(I2CDef *i2c, uint8_t devAddr, int16_t temp) {
+    if (i2c->number >= I2C_MOCK_MAX_DEVICES)
+        return NULL;
+
+    I2C_MockDevice_Def *dev = &i2c->devices[i2c->number++];
+    memset(dev, 0, sizeof(I2C_MockDevice_Def));
+    dev->addr = devAddr;
+    dev->isPresent = true;
+    dev->temp = temp;
+    dev->regs[WHOAMI_REG] = 0xA0;
+    return dev;
+}
+
+/**
+ * @brief Find the simulated device
+ * @param i2c is the I2C interface data structure
+ * @param devAddr is the device address (7 bits)
+ * @return the simulated device (NULL - there is no device)
+ */
+I2C_MockDevice_Def *I2C_Mock_getDevice(I2CDef *i2c, uint8_t devAddr) {
+    for (uint8_t i = 0; i < i2c->number; ++i) {
+        if (i2c->devices[i].addr == devAddr)
+            return &i2c->devices[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Get the simulated time (it can be used as STTS22H_GetTime_Def)
+ * @return time (us)
+ */
+uint32_t I2C_Mock_getTime(void) {
+    return now;
+}
+
+/**
+ * @brief Set the simulated time
+ * @param time is the new time (us)
+ */
+void I2C_Mock_setTime(uint32_t time) {
+    now = time;
+}
+
+/**
+ * @brief Advance the simulated time (the transfers and the conversions are finished)
+ * @param i2c is the I2C interface data structure
+ * @param time is the interval (us)
+ */
+void I2C_Mock_advance(I2CDef *i2c, uint32_t time) {
+    now += time;
+    for (uint8_t i = 0; i < i2c->number; ++i)
+        processDevice(&i2c->devices[i]);
+}
+
+/**
+ * @brief Get the duration of the transfer: START, device address, data bytes (every byte with ACK), STOP
+ * @param i2c is the I2C interface data structure
+ * @param dataSize is the number of the data bytes
+ * @return duration (us)
+ */
+uint32_t I2C_Mock_getTransferTime(const I2CDef *i2c, uint16_t dataSize) {
+    uint32_t bits = 1 + 9 * (1 + (uint32_t) dataSize) + 1;
+    return i2c->latency + (uint32_t) (((uint64_t) bits * 1000000 + i2c->speed - 1) / i2c->speed);
+}
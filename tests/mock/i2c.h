@@ -0,0 +1,109 @@
+#ifndef I2C_H
+#define I2C_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// host-side simulation of the I2C interface with STTS22H slaves (the API of the MCU I2C driver and the mock control)
+
+#ifndef I2C_MOCK_MAX_DEVICES
+#define I2C_MOCK_MAX_DEVICES 4
+#endif
+
+#define I2C_MOCK_REGISTERS 16
+#define I2C_MOCK_BUFFER_SIZE 16
+
+enum I2C_Errors {
+    I2C_SUCCESS = 0,
+
+    I2C_BUSY = -1,
+    I2C_FAILED = -2,
+
+    I2C_NUMBER_ERRORS = 2
+};
+
+enum I2C_MockSpeeds {
+    I2C_MOCK_STANDARD = 100000, // Hz
+    I2C_MOCK_FAST = 400000,
+    I2C_MOCK_FAST_PLUS = 1000000,
+};
+
+typedef struct {
+    uint8_t addr; // 7-bit device address
+    bool isPresent; // False - all transfers are not acknowledged
+    uint16_t nacks; // number of the next transfers, that are not acknowledged
+    uint8_t pointer; // register address of the next access
+    uint8_t regs[I2C_MOCK_REGISTERS];
+    int16_t temp; // 0.01C, value of the next conversions
+    bool isConverting;
+    uint32_t conversionEnd; // us
+} I2C_MockDevice_Def;
+
+typedef struct {
+    uint32_t transfers; // number of the started transfers
+    uint32_t nacks; // number of the transfers, that have been not acknowledged
+    uint32_t bytes; // number of the transferred bytes (device address isn't counted)
+    uint32_t busTime; // us, the bus has been occupied by the transfers
+} I2C_MockStats_Def;
+
+typedef struct I2CDef {
+    uint32_t speed; // Hz, SCL frequency (I2C_MockSpeeds values)
+    uint32_t latency; // us, start of every transfer (driver, DMA, interrupt)
+
+    bool isReading;
+    bool isWriting;
+    bool isFailed;
+    uint32_t endTime; // us, end of the current transfer
+
+    uint8_t number; // number of the devices
+    I2C_MockDevice_Def devices[I2C_MOCK_MAX_DEVICES];
+    uint8_t rxData[I2C_MOCK_BUFFER_SIZE];
+
+    I2C_MockStats_Def stats;
+} I2CDef;
+
+// I2C interface (functions of the MCU I2C driver, that are used by the library)
+
+int I2C_writeData(I2CDef *i2c, uint8_t devAddr, const void *data, uint16_t dataSize, bool isBlocking);
+
+int I2C_readData(I2CDef *i2c, uint8_t devAddr, uint16_t dataSize);
+
+const void *I2C_getReceivedData(const I2CDef *i2c);
+
+bool I2C_isReading(const I2CDef *i2c);
+
+bool I2C_isWriting(const I2CDef *i2c);
+
+bool I2C_isFailed(const I2CDef *i2c);
+
+// transfers of a DMA HAL (the combined write-then-read and the reading into the buffer of the caller)
+
+int I2C_Mock_writeRead(I2CDef *i2c, uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t dataSize);
+
+int I2C_Mock_readInto(I2CDef *i2c, uint8_t devAddr, uint8_t *data, uint16_t dataSize);
+
+// control of the simulation
+
+void I2C_Mock_init(I2CDef *i2c, uint32_t speed, uint32_t latency);
+
+I2C_MockDevice_Def *I2C_Mock_addDevice(I2CDef *i2c, uint8_t devAddr, int16_t temp);
+
+I2C_MockDevice_Def *I2C_Mock_getDevice(I2CDef *i2c, uint8_t devAddr);
+
+uint32_t I2C_Mock_getTime(void);
+
+void I2C_Mock_setTime(uint32_t time);
+
+void I2C_Mock_advance(I2CDef *i2c, uint32_t time);
+
+uint32_t I2C_Mock_getTransferTime(const I2CDef *i2c, uint16_t dataSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // I2C_H
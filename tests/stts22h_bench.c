@@ -0,0 +1,191 @@
+#include <stdio.h>
+
+#include "stts22h.h"
+#include "stts22h_bus.h"
+#include "cycles.h"
+
+// host-side benchmarks of the state machine on the simulated I2C bus (tests/mock/i2c.c)
+
+static const uint32_t TICK = 10; // us, period of the application loop
+static const uint32_t LATENCY = 20; // us, start of every transfer
+static const uint32_t DURATION = 1000000; // us, simulated time of the periodic modes
+static const uint32_t SAMPLES = 1000; // number of the measurements of the manual mode
+static const int16_t TEMP = 2537; // 0.01C
+
+// freerun 200Hz, IF_ADD_INC, BDU
+static const uint8_t CONTROL = 0x7C;
+
+typedef struct {
+    uint32_t samples;
+    uint32_t updates; // calls of STTS22H_update (STTS22H_Bus_update)
+    uint64_t cycles; // cycles of all update calls
+    uint32_t bytes; // bus bytes (device address isn't counted)
+    uint32_t failed; // transfers, that haven't been acknowledged
+    uint32_t time; // us, simulated time
+} Result_Def;
+
+/**
+ * @brief Call STTS22H_update and advance the simulated time by one loop period
+ * @param stts is the STTS22H data structure
+ * @param result is the measured values
+ */
+static void update(STTS22H_Def *stts, Result_Def *result) {
+    uint64_t start = STTS22H_getCycles();
+    STTS22H_update(stts);
+    result->cycles += STTS22H_getCycles() - start;
+    result->updates++;
+    I2C_Mock_advance(stts->i2c, TICK);
+}
+
+/**
+ * @brief Prepare the simulated bus with one sensor
+ * @param i2c is the I2C interface data structure
+ * @param stts is the STTS22H data structure
+ * @param speed is the SCL frequency (Hz)
+ */
+static void setup(I2CDef *i2c, STTS22H_Def *stts, uint32_t speed) {
+    I2C_Mock_setTime(0);
+    I2C_Mock_init(i2c, speed, LATENCY);
+    I2C_Mock_addDevice(i2c, STTS22H_ADDRESS_0, TEMP);
+    STTS22H_init(stts, i2c, STTS22H_ADDRESS(STTS22H_ADDRESS_0));
+    STTS22H_setTimeSource(stts, I2C_Mock_getTime);
+}
+
+/**
+ * @brief Measure SAMPLES values by STTS22H_measure (the sensor is in freerun mode)
+ * @param speed is the SCL frequency (Hz)
+ * @param result is the measured values
+ */
+static void benchMeasure(uint32_t speed, Result_Def *result) {
+    static I2CDef i2c;
+    STTS22H_Def stts;
+    setup(&i2c, &stts, speed);
+    STTS22H_setting(&stts, CONTROL);
+
+    uint32_t startTime = I2C_Mock_getTime();
+    I2C_MockStats_Def stats = i2c.stats;
+    for (uint32_t i = 0; i < SAMPLES; ++i) {
+        STTS22H_measure(&stts);
+        while (STTS22H_isBusy(&stts))
+            update(&stts, result);
+    }
+
+    result->samples = stts.sequence;
+    result->bytes = i2c.stats.bytes - stats.bytes;
+    result->failed = i2c.stats.nacks - stats.nacks;
+    result->time = I2C_Mock_getTime() - startTime;
+}
+
+/**
+ * @brief Run the periodic mode during DURATION
+ * @param speed is the SCL frequency (Hz)
+ * @param mode is STTS22H_MODE_ONE_SHOT or STTS22H_MODE_STREAMING
+ * @param result is the measured values
+ */
+static void benchPeriodic(uint32_t speed, uint8_t mode, Result_Def *result) {
+    static I2CDef i2c;
+    STTS22H_Def stts;
+    setup(&i2c, &stts, speed);
+    STTS22H_setting(&stts, (uint8_t) (CONTROL & ~0x04)); // power-down, IF_ADD_INC
+
+    if (mode == STTS22H_MODE_ONE_SHOT)
+        STTS22H_startOneShot(&stts, 50000);
+    else
+        STTS22H_startStreaming(&stts, STTS22H_AVG_200Hz);
+
+    uint32_t startTime = I2C_Mock_getTime();
+    I2C_MockStats_Def stats = i2c.stats;
+    while (I2C_Mock_getTime() - startTime < DURATION)
+        update(&stts, result);
+
+    result->samples = stts.sequence;
+    result->bytes = i2c.stats.bytes - stats.bytes;
+    result->failed = i2c.stats.nacks - stats.nacks;
+    result->time = I2C_Mock_getTime() - startTime;
+}
+
+/**
+ * @brief Measure all four addresses by the bus scheduler, the last sensor doesn't acknowledge every 16th request
+ * @param speed is the SCL frequency (Hz)
+ * @param result is the measured values
+ */
+static void benchBus(uint32_t speed, Result_Def *result) {
+    static const uint8_t ADDRESSES[] = {STTS22H_ADDRESS_0, STTS22H_ADDRESS_1, STTS22H_ADDRESS_2, STTS22H_ADDRESS_3};
+    static I2CDef i2c;
+    STTS22H_Def sensors[STTS22H_BUS_ADDRESSES];
+    STTS22H_Bus_Def bus;
+
+    I2C_Mock_setTime(0);
+    I2C_Mock_init(&i2c, speed, LATENCY);
+    STTS22H_Bus_init(&bus, &i2c);
+    STTS22H_Bus_setTimeSource(&bus, I2C_Mock_getTime);
+    for (uint8_t i = 0; i < STTS22H_BUS_ADDRESSES; ++i) {
+        I2C_Mock_addDevice(&i2c, ADDRESSES[i], (int16_t) (TEMP + i));
+        STTS22H_init(&sensors[i], &i2c, STTS22H_ADDRESS(ADDRESSES[i]));
+        STTS22H_setTimeSource(&sensors[i], I2C_Mock_getTime);
+        STTS22H_setting(&sensors[i], CONTROL);
+        STTS22H_Bus_addSensor(&bus, &sensors[i]);
+    }
+
+    uint32_t startTime = I2C_Mock_getTime();
+    I2C_MockStats_Def stats = i2c.stats;
+    for (uint32_t i = 0; i < SAMPLES / STTS22H_BUS_ADDRESSES; ++i) {
+        if ((i % 16) == 15)
+            I2C_Mock_getDevice(&i2c, STTS22H_ADDRESS_3)->nacks = 1;
+
+        STTS22H_Bus_measureAll(&bus);
+        while (STTS22H_Bus_isBusy(&bus)) {
+            uint64_t start = STTS22H_getCycles();
+            STTS22H_Bus_update(&bus);
+            result->cycles += STTS22H_getCycles() - start;
+            result->updates++;
+            I2C_Mock_advance(&i2c, TICK);
+        }
+    }
+
+    for (uint8_t i = 0; i < STTS22H_BUS_ADDRESSES; ++i)
+        result->samples += sensors[i].sequence;
+    result->bytes = i2c.stats.bytes - stats.bytes;
+    result->failed = i2c.stats.nacks - stats.nacks;
+    result->time = I2C_Mock_getTime() - startTime;
+}
+
+/**
+ * @brief Print one line of the results table
+ * @param speed is the SCL frequency (Hz)
+ * @param name is the benchmark name
+ * @param result is the measured values
+ */
+static void print(uint32_t speed, const char *name, const Result_Def *result) {
+    uint32_t samples = (result->samples != 0) ? result->samples : 1;
+    uint32_t updates = (result->updates != 0) ? result->updates : 1;
+    printf("%7lu kHz  %-10s %8lu %10.1f %11.2f %9.2f %7lu %10.1f\n", (unsigned long) (speed / 1000), name,
+           (unsigned long) result->samples, (double) result->samples * 1e6 / (double) result->time,
+           (double) result->updates / samples, (double) result->bytes / samples, (unsigned long) result->failed,
+           (double) result->cycles / updates);
+}
+
+int main(void) {
+    static const uint32_t SPEEDS[] = {I2C_MOCK_STANDARD, I2C_MOCK_FAST, I2C_MOCK_FAST_PLUS};
+
+    printf("loop period %lu us, transfer latency %lu us\n", (unsigned long) TICK, (unsigned long) LATENCY);
+    printf("    speed  benchmark   samples  samples/s  updates/smp  bytes/smp  nacks  cycles/upd\n");
+    for (size_t i = 0; i < sizeof(SPEEDS) / sizeof(SPEEDS[0]); ++i) {
+        Result_Def result = {0};
+        benchMeasure(SPEEDS[i], &result);
+        print(SPEEDS[i], "measure", &result);
+
+        result = (Result_Def) {0};
+        benchPeriodic(SPEEDS[i], STTS22H_MODE_ONE_SHOT, &result);
+        print(SPEEDS[i], "one-shot", &result);
+
+        result = (Result_Def) {0};
+        benchPeriodic(SPEEDS[i], STTS22H_MODE_STREAMING, &result);
+        print(SPEEDS[i], "streaming", &result);
+
+        result = (Result_Def) {0};
+        benchBus(SPEEDS[i], &result);
+        print(SPEEDS[i], "bus x4", &result);
+    }
+    return 0;
+}
@@ -0,0 +1,481 @@
+#include <stdio.h>
+
+#include "stts22h.h"
+#include "stts22h_bus.h"
+#include "stts22h_fifo.h"
+#include "stts22h_filter.h"
+#include "stts22h_log.h"
+
+// checks of the optional features on the simulated I2C bus (tests/mock/i2c.c), the driver is built
+// with STTS22H_USE_DEADBAND = 1 and STTS22H_USE_ADAPTIVE = 1
+
+static const uint32_t TICK = 100; // us, period of the application loop
+static const uint32_t INSTANT = 1000; // us, every transfer is finished before the next update call
+static const int16_t TEMP = 2537; // 0.01C
+
+// freerun 200Hz, IF_ADD_INC, BDU
+static const uint8_t CONTROL = 0x7C;
+// power-down, IF_ADD_INC, BDU, 200Hz averaging of the one-shot conversions
+static const uint8_t POWER_DOWN = 0x78;
+
+static unsigned failures = 0;
+
+#define CHECK(condition) check((condition), #condition, __LINE__)
+
+/**
+ * @brief Report the failed check
+ * @param isPassed is the result of the check
+ * @param text is the checked expression
+ * @param line is the source line
+ */
+static void check(bool isPassed, const char *text, int line) {
+    if (!isPassed) {
+        printf("%s:%d: check failed: %s\n", __FILE__, line, text);
+        failures++;
+    }
+}
+
+/**
+ * @brief Prepare the simulated bus with one sensor in freerun mode (the first conversion is finished)
+ * @param i2c is the I2C interface data structure
+ * @param stts is the STTS22H data structure
+ * @return the simulated device
+ */
+static I2C_MockDevice_Def *setup(I2CDef *i2c, STTS22H_Def *stts) {
+    I2C_Mock_setTime(0);
+    I2C_Mock_init(i2c, I2C_MOCK_FAST, 0);
+    I2C_MockDevice_Def *dev = I2C_Mock_addDevice(i2c, STTS22H_ADDRESS_0, TEMP);
+    STTS22H_init(stts, i2c, STTS22H_ADDRESS(STTS22H_ADDRESS_0));
+    STTS22H_setTimeSource(stts, I2C_Mock_getTime);
+    CHECK(STTS22H_setting(stts, CONTROL) == STTS22H_SUCCESS);
+    I2C_Mock_advance(i2c, 10000);
+    return dev;
+}
+
+/**
+ * @brief Measure the temperature of the simulated device
+ * @param stts is the STTS22H data structure
+ * @param dev is the simulated device
+ * @param temp is the temperature of the device (0.01C)
+ */
+static void measure(STTS22H_Def *stts, I2C_MockDevice_Def *dev, int16_t temp) {
+    dev->temp = temp;
+    I2C_Mock_advance(stts->i2c, 10000); // the next conversion of freerun mode
+    CHECK(STTS22H_measure(stts) == STTS22H_SUCCESS);
+    for (uint32_t i = 0; i < 10 && STTS22H_isBusy(stts); ++i) {
+        I2C_Mock_advance(stts->i2c, INSTANT);
+        STTS22H_update(stts);
+    }
+    CHECK(STTS22H_getResult(stts) == STTS22H_SUCCESS && stts->temp == temp);
+}
+
+/**
+ * @brief The log encoder and decoder: every delta size, the status change, the sequence gap and the keyframes
+ */
+static void testLog(void) {
+    static const int16_t DELTAS[] = {0, 1, -1, 63, -64, 64, -65, 1000, -3000, 0, 5, -5};
+    static uint8_t page[256];
+    STTS22H_Sample_Def samples[40];
+    STTS22H_LogEncoder_Def encoder;
+
+    CHECK(STTS22H_Log_initEncoder(&encoder, 8) == STTS22H_SUCCESS);
+    STTS22H_Log_setPage(&encoder, page, sizeof(page));
+    int16_t raw = TEMP;
+    uint16_t sequence = 65530; // the sequence number is wrapped
+    for (uint32_t i = 0; i < sizeof(samples) / sizeof(samples[0]); ++i) {
+        raw = (int16_t) (raw + DELTAS[i % (sizeof(DELTAS) / sizeof(DELTAS[0]))]);
+        sequence = (uint16_t) (sequence + ((i == 20) ? 3 : 1)); // the lost samples
+        samples[i].raw = raw;
+        samples[i].status.full = (i >= 10 && i < 14) ? 0x02 : 0x00; // over_thh
+        samples[i].sequence = sequence;
+        samples[i].timestamp = 1000 + 5000 * i;
+        CHECK(STTS22H_Log_encode(&encoder, &samples[i]) == STTS22H_SUCCESS);
+    }
+    CHECK(!STTS22H_Log_isFull(&encoder));
+
+    STTS22H_LogDecoder_Def decoder;
+    STTS22H_Log_initDecoder(&decoder, page, STTS22H_Log_getLength(&encoder));
+    uint32_t keyframes = 0;
+    for (uint32_t i = 0; i < sizeof(samples) / sizeof(samples[0]); ++i) {
+        STTS22H_Sample_Def sample;
+        CHECK(STTS22H_Log_decode(&decoder, &sample) == STTS22H_SUCCESS);
+        CHECK(sample.raw == samples[i].raw);
+        CHECK(sample.status.full == samples[i].status.full);
+        CHECK(sample.sequence == samples[i].sequence);
+        // the timestamps are stored only in the keyframes
+        if (sample.timestamp != 0) {
+            CHECK(sample.timestamp == samples[i].timestamp);
+            keyframes++;
+        }
+    }
+    CHECK(keyframes >= 1 + 40 / 8 && keyframes <= 2 + 40 / 8); // the interval and the gap
+    STTS22H_Sample_Def sample;
+    CHECK(STTS22H_Log_decode(&decoder, &sample) == STTS22H_BUSY);
+
+    // the full page: the keyframe and one delta
+    STTS22H_Log_setPage(&encoder, page, STTS22H_LOG_KEYFRAME_SIZE + 1);
+    uint32_t dropped = encoder.dropped;
+    CHECK(STTS22H_Log_encode(&encoder, &samples[0]) == STTS22H_SUCCESS);
+    CHECK(STTS22H_Log_encode(&encoder, &samples[1]) == STTS22H_SUCCESS);
+    CHECK(STTS22H_Log_encode(&encoder, &samples[2]) == STTS22H_BUSY);
+    CHECK(STTS22H_Log_isFull(&encoder) && encoder.dropped == dropped + 1);
+}
+
+/**
+ * @brief The full ring buffer keeps the oldest samples and counts the lost ones, the unread sample is counted
+ * as overrun
+ */
+static void testFifo(void) {
+    static I2CDef i2c;
+    static STTS22H_Fifo_Def fifo;
+    STTS22H_Def stts;
+    I2C_MockDevice_Def *dev = setup(&i2c, &stts);
+    STTS22H_Fifo_init(&fifo);
+    STTS22H_attachFifo(&stts, &fifo);
+
+    const uint32_t number = STTS22H_FIFO_SIZE + 8;
+    for (uint32_t i = 0; i < number; ++i)
+        measure(&stts, dev, (int16_t) (TEMP + i));
+    CHECK(STTS22H_Fifo_getCount(&fifo) == STTS22H_FIFO_SIZE);
+    CHECK(STTS22H_Fifo_getDropped(&fifo) == number - STTS22H_FIFO_SIZE);
+    CHECK(STTS22H_getOverruns(&stts) == number - 1);
+
+    STTS22H_Sample_Def samples[STTS22H_FIFO_SIZE];
+    CHECK(STTS22H_Fifo_pop(&fifo, samples, STTS22H_FIFO_SIZE) == STTS22H_FIFO_SIZE);
+    for (uint32_t i = 0; i < STTS22H_FIFO_SIZE; ++i)
+        CHECK(samples[i].sequence == i + 1 && samples[i].raw == TEMP + (int32_t) i);
+    CHECK(STTS22H_Fifo_getCount(&fifo) == 0);
+
+    // the taken sample isn't an overrun
+    STTS22H_Sample_Def sample;
+    CHECK(STTS22H_getSample(&stts, &sample) && sample.sequence == number);
+    CHECK(!STTS22H_getSample(&stts, &sample));
+    measure(&stts, dev, TEMP);
+    CHECK(STTS22H_getOverruns(&stts) == number - 1);
+    CHECK(STTS22H_Fifo_getCount(&fifo) == 1 && STTS22H_Fifo_getDropped(&fifo) == number - STTS22H_FIFO_SIZE);
+}
+
+static int16_t filtered[8];
+static uint32_t filteredNumber;
+
+/**
+ * @brief Record the output value of the filter
+ */
+static void onFiltered(STTS22H_Def *stts, int16_t temp) {
+    (void) stts;
+    if (filteredNumber < sizeof(filtered) / sizeof(filtered[0]))
+        filtered[filteredNumber] = temp;
+    filteredNumber++;
+}
+
+/**
+ * @brief Moving average of 4 values with 2:1 decimation, the exponential filter
+ */
+static void testFilter(void) {
+    static const int16_t EXPECTED[] = {150, 250, 450, 650}; // (100, 200), (100...400), (300...600), (500...800)
+    static I2CDef i2c;
+    STTS22H_Filter_Def filter;
+    STTS22H_Def stts;
+    I2C_MockDevice_Def *dev = setup(&i2c, &stts);
+
+    CHECK(STTS22H_Filter_init(&filter, STTS22H_FILTER_MOVING_AVERAGE, 0, 1) == STTS22H_WRONG_DATA);
+    CHECK(STTS22H_Filter_init(&filter, STTS22H_FILTER_MOVING_AVERAGE, 4, 2) == STTS22H_SUCCESS);
+    STTS22H_attachFilter(&stts, &filter, onFiltered);
+    filteredNumber = 0;
+    for (int16_t i = 1; i <= 8; ++i)
+        measure(&stts, dev, (int16_t) (100 * i));
+    CHECK(filteredNumber == sizeof(EXPECTED) / sizeof(EXPECTED[0]));
+    for (uint32_t i = 0; i < sizeof(EXPECTED) / sizeof(EXPECTED[0]); ++i)
+        CHECK(filtered[i] == EXPECTED[i]);
+    CHECK(!STTS22H_Filter_isReady(&filter) && STTS22H_Filter_getOutput(&filter) == 650); // taken by the driver
+
+    // y += (x - y) / 2: the first value, then a half of the step
+    CHECK(STTS22H_Filter_init(&filter, STTS22H_FILTER_EXPONENTIAL, 1, 1) == STTS22H_SUCCESS);
+    filteredNumber = 0;
+    measure(&stts, dev, 1000);
+    measure(&stts, dev, 2000);
+    measure(&stts, dev, 2000);
+    CHECK(filteredNumber == 3 && filtered[0] == 1000 && filtered[1] == 1500 && filtered[2] == 1750);
+}
+
+static uint32_t significantNumber;
+
+/**
+ * @brief Count the significant samples
+ */
+static void onSignificant(STTS22H_Def *stts, int16_t temp) {
+    (void) stts;
+    (void) temp;
+    significantNumber++;
+}
+
+/**
+ * @brief The significant samples: the change is more than the deadband or the heartbeat interval has expired
+ */
+static void testDeadband(void) {
+    static const uint32_t HEARTBEAT = 100000; // us
+    static I2CDef i2c;
+    STTS22H_Def stts;
+    I2C_MockDevice_Def *dev = setup(&i2c, &stts);
+    measure(&stts, dev, TEMP);
+    STTS22H_setDeadband(&stts, 50, HEARTBEAT, onSignificant);
+    significantNumber = 0;
+
+    measure(&stts, dev, TEMP + 50); // the change is equal to the deadband
+    CHECK(significantNumber == 0 && !STTS22H_isSignificant(&stts));
+    measure(&stts, dev, TEMP - 50);
+    CHECK(significantNumber == 0);
+    measure(&stts, dev, TEMP + 51);
+    CHECK(significantNumber == 1 && STTS22H_isSignificant(&stts) && stts.temp == TEMP + 51);
+    STTS22H_clearSignificant(&stts);
+    CHECK(!STTS22H_isSignificant(&stts));
+
+    // the change is measured from the last significant value
+    measure(&stts, dev, TEMP + 100);
+    CHECK(significantNumber == 1);
+    measure(&stts, dev, TEMP + 102);
+    CHECK(significantNumber == 2);
+
+    // the same value: only the heartbeat (the samples are measured every 12 ms)
+    uint32_t startTime = I2C_Mock_getTime();
+    while (I2C_Mock_getTime() - startTime < HEARTBEAT - 15000)
+        measure(&stts, dev, TEMP + 102);
+    CHECK(significantNumber == 2);
+    measure(&stts, dev, TEMP + 102);
+    measure(&stts, dev, TEMP + 102);
+    CHECK(significantNumber == 3);
+
+    // turned OFF
+    STTS22H_setDeadband(&stts, 0, 0, NULL);
+    measure(&stts, dev, TEMP - 1000);
+    CHECK(significantNumber == 3 && !STTS22H_isSignificant(&stts));
+}
+
+/**
+ * @brief Stream the samples, the temperature of the device is changed linearly
+ * @param stts is the STTS22H data structure
+ * @param dev is the simulated device
+ * @param duration is the simulated time (us)
+ * @param slope is the rate of change of the device temperature (0.01C/s)
+ */
+static void stream(STTS22H_Def *stts, I2C_MockDevice_Def *dev, uint32_t duration, int32_t slope) {
+    int32_t temp = dev->temp;
+    for (uint32_t time = 0; time < duration; time += TICK) {
+        dev->temp = (int16_t) (temp + slope * (int32_t) time / 1000000);
+        STTS22H_update(stts);
+        I2C_Mock_advance(stts->i2c, TICK);
+    }
+}
+
+/**
+ * @brief Adaptive rate: the slow change decreases the rate after the hold windows, the fast change sets
+ * the maximum rate, the change between the thresholds keeps the current rate (hysteresis)
+ */
+static void testAdaptive(void) {
+    static const STTS22H_Adaptive_Def ADAPTIVE = {
+            .upper = 200, // 2C/s
+            .lower = 50, // 0.5C/s
+            .window = 100000, // us
+            .hold = 2,
+            .minRate = STTS22H_RATE_25Hz,
+            .maxRate = STTS22H_RATE_200Hz
+    };
+    static I2CDef i2c;
+    STTS22H_Def stts;
+    I2C_MockDevice_Def *dev = setup(&i2c, &stts);
+    STTS22H_Adaptive_Def wrong = ADAPTIVE;
+    wrong.lower = 300;
+    CHECK(STTS22H_setAdaptive(&stts, &wrong) == STTS22H_WRONG_DATA);
+    CHECK(STTS22H_setAdaptive(&stts, &ADAPTIVE) == STTS22H_SUCCESS);
+    CHECK(STTS22H_startStreaming(&stts, STTS22H_AVG_100Hz) == STTS22H_SUCCESS);
+
+    // the constant temperature: one step down after two windows, then the minimum rate
+    stream(&stts, dev, 150000, 0);
+    CHECK(STTS22H_getRate(&stts) == STTS22H_RATE_100Hz);
+    stream(&stts, dev, 150000, 0);
+    CHECK(STTS22H_getRate(&stts) == STTS22H_RATE_50Hz);
+    stream(&stts, dev, 700000, 0);
+    CHECK(STTS22H_getRate(&stts) == STTS22H_RATE_25Hz);
+
+    // between the thresholds the rate isn't changed
+    stream(&stts, dev, 1000000, 100);
+    CHECK(STTS22H_getRate(&stts) == STTS22H_RATE_25Hz);
+
+    // the fast change: the maximum rate at once, it is kept between the thresholds
+    stream(&stts, dev, 200000, 2000);
+    CHECK(STTS22H_getRate(&stts) == STTS22H_RATE_200Hz);
+    stream(&stts, dev, 1000000, -100);
+    CHECK(STTS22H_getRate(&stts) == STTS22H_RATE_200Hz);
+    CHECK((I2C_Mock_getDevice(&i2c, STTS22H_ADDRESS_0)->regs[0x04] & 0x30) == 0x30); // avg of 200Hz
+
+    // the slow windows aren't one by one: every window between the thresholds restarts the hold
+    for (uint32_t i = 0; i < 10; ++i) {
+        stream(&stts, dev, 100000, 0);
+        stream(&stts, dev, 100000, 120);
+    }
+    CHECK(STTS22H_getRate(&stts) == STTS22H_RATE_200Hz);
+
+    stream(&stts, dev, 2000000, 0);
+    CHECK(STTS22H_getRate(&stts) == STTS22H_RATE_25Hz);
+    STTS22H_stopStreaming(&stts);
+}
+
+/**
+ * @brief Prepare the scheduler of the simulated sensors
+ * @param i2c is the I2C interface data structure
+ * @param bus is the bus scheduler data structure
+ * @param sensors is the array of the STTS22H data structures
+ * @param number is the number of the sensors
+ * @param control is the control register value of the sensors
+ */
+static void setupBus(I2CDef *i2c, STTS22H_Bus_Def *bus, STTS22H_Def *sensors, uint8_t number, uint8_t control) {
+    static const uint8_t ADDRESSES[] = {STTS22H_ADDRESS_0, STTS22H_ADDRESS_1, STTS22H_ADDRESS_2, STTS22H_ADDRESS_3};
+
+    I2C_Mock_setTime(0);
+    I2C_Mock_init(i2c, I2C_MOCK_FAST, 20);
+    CHECK(STTS22H_Bus_init(bus, i2c) == STTS22H_SUCCESS);
+    STTS22H_Bus_setTimeSource(bus, I2C_Mock_getTime);
+    for (uint8_t i = 0; i < number; ++i) {
+        I2C_Mock_addDevice(i2c, ADDRESSES[i], (int16_t) (TEMP + i));
+        STTS22H_init(&sensors[i], i2c, STTS22H_ADDRESS(ADDRESSES[i]));
+        STTS22H_setTimeSource(&sensors[i], I2C_Mock_getTime);
+        CHECK(STTS22H_setting(&sensors[i], control) == STTS22H_SUCCESS);
+        CHECK(STTS22H_Bus_addSensor(bus, &sensors[i]) == STTS22H_SUCCESS);
+    }
+    I2C_Mock_advance(i2c, 10000);
+}
+
+/**
+ * @brief Call STTS22H_Bus_update until the end of the queued requests
+ * @param bus is the bus scheduler data structure
+ * @param step is the simulated time between the update calls (us)
+ */
+static void finishBus(STTS22H_Bus_Def *bus, uint32_t step) {
+    for (uint32_t i = 0; i < 100000 && STTS22H_Bus_isBusy(bus); ++i) {
+        I2C_Mock_advance(bus->i2c, step);
+        STTS22H_Bus_update(bus);
+    }
+}
+
+static uint8_t missedIndex;
+static uint32_t missedLateness;
+static uint32_t missedNumber;
+
+/**
+ * @brief Record the missed deadline
+ */
+static void onMissed(STTS22H_Bus_Def *bus, uint8_t index, uint32_t lateness) {
+    (void) bus;
+    missedIndex = index;
+    missedLateness = lateness;
+    missedNumber++;
+}
+
+/**
+ * @brief The deadlines of the measurements: the late and the failed measurements are missed
+ */
+static void testDeadline(void) {
+    static I2CDef i2c;
+    STTS22H_Def sensors[2];
+    STTS22H_Bus_Def bus;
+    setupBus(&i2c, &bus, sensors, 2, CONTROL);
+    STTS22H_Bus_setMissedCallback(&bus, onMissed);
+    missedNumber = 0;
+
+    CHECK(STTS22H_Bus_measureBefore(&bus, 0, 10000) == STTS22H_SUCCESS);
+    finishBus(&bus, TICK);
+    CHECK(missedNumber == 0 && STTS22H_Bus_getMissed(&bus, 0) == 0);
+
+    // two transfers of 20 us latency can't be finished in 50 us
+    CHECK(STTS22H_Bus_measureBefore(&bus, 1, 50) == STTS22H_SUCCESS);
+    finishBus(&bus, 10);
+    CHECK(missedNumber == 1 && missedIndex == 1 && missedLateness > 0);
+    CHECK(STTS22H_Bus_getMissed(&bus, 1) == 1 && STTS22H_Bus_getMissed(&bus, 0) == 0);
+    CHECK(sensors[1].sequence == 1);
+
+    // the failed measurement misses its deadline before it
+    I2C_Mock_getDevice(&i2c, STTS22H_ADDRESS_0)->nacks = 1;
+    CHECK(STTS22H_Bus_measureBefore(&bus, 0, 10000) == STTS22H_SUCCESS);
+    finishBus(&bus, TICK);
+    CHECK(missedNumber == 2 && missedIndex == 0 && missedLateness == 0);
+    CHECK(STTS22H_Bus_getMissed(&bus, 0) == 1);
+}
+
+/**
+ * @brief The snapshot: the one-shot conversions are started back to back, the skew is the start of the last one
+ */
+static void testSnapshot(void) {
+    static I2CDef i2c;
+    STTS22H_Def sensors[STTS22H_BUS_MAX_SENSORS];
+    STTS22H_Bus_Def bus;
+    setupBus(&i2c, &bus, sensors, STTS22H_BUS_MAX_SENSORS, POWER_DOWN);
+    finishBus(&bus, TICK); // the setting
+
+    CHECK(STTS22H_Bus_snapshot(&bus) == STTS22H_SUCCESS);
+    for (uint32_t i = 0; i < 100000 && !STTS22H_Bus_isSnapshotReady(&bus); ++i) {
+        I2C_Mock_advance(&i2c, 10);
+        STTS22H_Bus_update(&bus);
+    }
+    STTS22H_Snapshot_Def snapshot;
+    CHECK(STTS22H_Bus_getSnapshot(&bus, &snapshot) == STTS22H_SUCCESS);
+    CHECK(snapshot.valid == (1U << STTS22H_BUS_MAX_SENSORS) - 1);
+
+    // one CTRL write per sensor (the register address and the value)
+    uint32_t write = I2C_Mock_getTransferTime(&i2c, 2);
+    // the sensors are started in the round-robin order: the offsets are sorted
+    uint32_t offsets[STTS22H_BUS_MAX_SENSORS];
+    for (uint8_t i = 0; i < STTS22H_BUS_MAX_SENSORS; ++i) {
+        CHECK(snapshot.temp[i] == TEMP + i);
+        uint8_t k = i;
+        for (; k > 0 && offsets[k - 1] > snapshot.offsets[i]; --k)
+            offsets[k] = offsets[k - 1];
+        offsets[k] = snapshot.offsets[i];
+    }
+    CHECK(offsets[0] == 0);
+    for (uint8_t i = 1; i < STTS22H_BUS_MAX_SENSORS; ++i)
+        CHECK(offsets[i] >= offsets[i - 1] + write && offsets[i] <= offsets[i - 1] + write + 2 * 10);
+    CHECK(snapshot.skew == offsets[STTS22H_BUS_MAX_SENSORS - 1]);
+    CHECK(STTS22H_Bus_getSnapshot(&bus, &snapshot) == STTS22H_WRONG_DATA);
+}
+
+/**
+ * @brief Discovery: the presence mask of the answered addresses, the found sensors are configured
+ */
+static void testDiscovery(void) {
+    static const STTS22H_BusConfig_Def CONFIG = {.controlReg = CONTROL, .isSetLimits = false};
+    static I2CDef i2c;
+    STTS22H_Def sensors[STTS22H_BUS_ADDRESSES];
+    STTS22H_Bus_Def bus;
+
+    I2C_Mock_setTime(0);
+    I2C_Mock_init(&i2c, I2C_MOCK_FAST, 0);
+    I2C_Mock_addDevice(&i2c, STTS22H_ADDRESS_1, TEMP);
+    I2C_Mock_addDevice(&i2c, STTS22H_ADDRESS_3, TEMP);
+    CHECK(STTS22H_Bus_init(&bus, &i2c) == STTS22H_SUCCESS);
+    CHECK(STTS22H_Bus_discover(&bus, sensors, &CONFIG) == STTS22H_SUCCESS);
+    finishBus(&bus, INSTANT);
+
+    CHECK(STTS22H_Bus_getPresence(&bus) == ((1U << 1) | (1U << 3)));
+    CHECK(bus.number == 2);
+    CHECK(bus.sensors[0] == &sensors[1] && bus.sensors[1] == &sensors[3]);
+    CHECK(I2C_Mock_getDevice(&i2c, STTS22H_ADDRESS_1)->regs[0x04] == CONTROL);
+    CHECK(I2C_Mock_getDevice(&i2c, STTS22H_ADDRESS_3)->regs[0x04] == CONTROL);
+}
+
+int main(void) {
+    testLog();
+    testFifo();
+    testFilter();
+    testDeadband();
+    testAdaptive();
+    testDeadline();
+    testSnapshot();
+    testDiscovery();
+
+    if (failures != 0) {
+        printf("%u checks failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,243 @@
+#define _GNU_SOURCE // pthread, getpid
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "stts22h_linux.h"
+
+// checks of the i2c-dev transport and the shared memory ring buffer, ioctl of the bus is simulated
+// (the executable is linked with --wrap=ioctl)
+
+static const uint8_t ADDRESSES[] = {STTS22H_ADDRESS_0, STTS22H_ADDRESS_1, STTS22H_ADDRESS_2, STTS22H_ADDRESS_3};
+static const uint32_t PASSES = 200000; // reading passes of the concurrent writer
+static const uint32_t CAPACITY = 8; // records, the writer overwrites the records of the slow reader
+
+typedef struct {
+    bool isPresent;
+    uint8_t pointer;
+    uint8_t regs[16];
+} Device_Def;
+
+static Device_Def devices[128];
+static uint16_t pass; // the temperature value of the next pass (raw, it is checked by the reader)
+static uint32_t ioctls; // number of the I2C_RDWR calls
+static uint32_t messages; // number of the messages of the last I2C_RDWR call
+
+static unsigned failures = 0;
+
+#define CHECK(condition) check((condition), #condition, __LINE__)
+
+/**
+ * @brief Report the failed check
+ * @param isPassed is the result of the check
+ * @param text is the checked expression
+ * @param line is the source line
+ */
+static void check(bool isPassed, const char *text, int line) {
+    if (!isPassed) {
+        printf("%s:%d: check failed: %s\n", __FILE__, line, text);
+        failures++;
+    }
+}
+
+int __real_ioctl(int fd, unsigned long request, ...);
+
+/**
+ * @brief Simulated i2c-dev bus with STTS22H slaves (the register address is incremented by every byte)
+ */
+int __wrap_ioctl(int fd, unsigned long request, ...) {
+    va_list args;
+    va_start(args, request);
+    void *arg = va_arg(args, void *);
+    va_end(args);
+    (void) fd;
+
+    if (request == I2C_FUNCS) {
+        *(unsigned long *) arg = I2C_FUNC_I2C;
+        return 0;
+    }
+    if (request != I2C_RDWR)
+        return -1;
+
+    struct i2c_rdwr_ioctl_data *data = arg;
+    ioctls++;
+    messages = data->nmsgs;
+    for (uint32_t i = 0; i < data->nmsgs; ++i) {
+        struct i2c_msg *msg = &data->msgs[i];
+        Device_Def *dev = &devices[msg->addr & 0x7F];
+        if (!dev->isPresent)
+            return -1;
+
+        if (msg->flags & I2C_M_RD) {
+            uint16_t value = (uint16_t) (pass + (msg->addr & 0x03));
+            dev->regs[0x05] = (uint8_t) (pass << 3); // STATUS, the reserved bits (the conversion is finished)
+            dev->regs[0x06] = (uint8_t) value;
+            dev->regs[0x07] = (uint8_t) (value >> 8);
+            for (uint16_t k = 0; k < msg->len; ++k)
+                msg->buf[k] = dev->regs[(dev->pointer + k) & 0x0F];
+        } else if (msg->len != 0) {
+            dev->pointer = msg->buf[0] & 0x0F;
+            for (uint16_t k = 1; k < msg->len; ++k)
+                dev->regs[(dev->pointer + k - 1) & 0x0F] = msg->buf[k];
+        }
+    }
+    return (int) data->nmsgs;
+}
+
+/**
+ * @brief Open the simulated bus with four sensors
+ * @param dev is the Linux bus data structure
+ */
+static void setup(STTS22H_Linux_Def *dev) {
+    memset(devices, 0, sizeof(devices));
+    for (uint8_t i = 0; i < sizeof(ADDRESSES); ++i) {
+        devices[ADDRESSES[i]].isPresent = true;
+        devices[ADDRESSES[i]].regs[0x01] = 0xA0; // WHOAMI
+    }
+
+    CHECK(STTS22H_Linux_open(dev, "/dev/null") == STTS22H_SUCCESS);
+    for (uint8_t i = 0; i < sizeof(ADDRESSES); ++i)
+        CHECK(STTS22H_Linux_addSensor(dev, ADDRESSES[i]) == STTS22H_SUCCESS);
+}
+
+/**
+ * @brief One ioctl per reading pass, the sensor, that doesn't answer, is excluded from the combined transfer
+ */
+static void testTransfer(void) {
+    static STTS22H_Linux_Def dev;
+    setup(&dev);
+
+    CHECK(STTS22H_Linux_configure(&dev, STTS22H_AVG_200Hz) == STTS22H_SUCCESS);
+    CHECK(dev.period != 0);
+    CHECK(devices[ADDRESSES[0]].regs[0x04] & 0x04); // freerun
+
+    pass = 2537;
+    ioctls = 0;
+    CHECK(STTS22H_Linux_read(&dev) == STTS22H_SUCCESS);
+    CHECK(ioctls == 1 && messages == 2 * sizeof(ADDRESSES));
+    CHECK(dev.sensors[0].temp == 2537 + (ADDRESSES[0] & 0x03));
+    CHECK(dev.sensors[3].temp == 2537 + (ADDRESSES[3] & 0x03));
+
+    // the sensor stops answering: it is checked alone, then the combined transfer skips it
+    devices[ADDRESSES[2]].isPresent = false;
+    for (uint32_t i = 0; i < 2 * STTS22H_MAX_FAILURES; ++i)
+        CHECK(STTS22H_Linux_read(&dev) == STTS22H_SUCCESS);
+    CHECK(dev.absent == (1U << 2));
+    CHECK(STTS22H_isDegraded(&dev.sensors[2]));
+
+    ioctls = 0;
+    CHECK(STTS22H_Linux_read(&dev) == STTS22H_SUCCESS);
+    CHECK(ioctls == 1 && messages == 2 * (sizeof(ADDRESSES) - 1));
+
+    // the degraded sensor isn't configured
+    CHECK(STTS22H_Linux_configure(&dev, STTS22H_AVG_200Hz) == STTS22H_NOT_CONNECTED);
+
+    STTS22H_Linux_close(&dev);
+}
+
+typedef struct {
+    const char *name;
+    atomic_bool isRunning;
+    uint32_t received;
+    uint32_t lost;
+    uint32_t torn; // records with the fields of the different passes
+    uint32_t unordered; // records, that are older than the previous one
+} Reader_Def;
+
+/**
+ * @brief Consumer of the ring buffer: every record should be complete and newer than the previous one
+ * @param arg is the reader data structure
+ * @return NULL
+ */
+static void *readRing(void *arg) {
+    Reader_Def *state = arg;
+    STTS22H_LinuxReader_Def reader;
+    if (STTS22H_Linux_openRing(&reader, state->name) != STTS22H_SUCCESS)
+        return NULL;
+
+    uint16_t lastSequence = 0;
+    uint8_t lastIndex = 0;
+    while (true) {
+        bool isStopped = !atomic_load(&state->isRunning); // the records of the stopped writer are read to the end
+        STTS22H_LinuxRecord_Def records[3];
+        size_t number = STTS22H_Linux_readRing(&reader, records, sizeof(records) / sizeof(records[0]));
+        for (size_t i = 0; i < number; ++i) {
+            const STTS22H_LinuxRecord_Def *record = &records[i];
+            uint16_t value = (uint16_t) ((uint16_t) record->temp - (ADDRESSES[record->index & 0x03] & 0x03));
+            if (!record->isValid || record->sequence != value || record->status != (uint8_t) (value << 3))
+                state->torn++;
+
+            // the sequence number is wrapped
+            int16_t difference = (int16_t) (record->sequence - lastSequence);
+            if (state->received != 0 && (difference < 0 || (difference == 0 && record->index <= lastIndex)))
+                state->unordered++;
+            lastSequence = record->sequence;
+            lastIndex = record->index;
+            state->received++;
+        }
+        if (isStopped && number == 0)
+            break;
+    }
+
+    state->lost = reader.lost;
+    STTS22H_Linux_closeRing(&reader);
+    return NULL;
+}
+
+/**
+ * @brief The concurrent writer overwrites the records of the slow reader: the torn records aren't accepted,
+ * every record is received or counted as lost
+ */
+static void testRing(void) {
+    static STTS22H_Linux_Def dev;
+    setup(&dev);
+    CHECK(STTS22H_Linux_configure(&dev, STTS22H_AVG_200Hz) == STTS22H_SUCCESS);
+
+    char name[32];
+    snprintf(name, sizeof(name), "/stts22h_test_%d", (int) getpid());
+    CHECK(STTS22H_Linux_createRing(&dev, name, CAPACITY) == STTS22H_SUCCESS);
+
+    Reader_Def state = {.name = name};
+    atomic_init(&state.isRunning, true);
+    pthread_t thread;
+    CHECK(pthread_create(&thread, NULL, readRing, &state) == 0);
+    usleep(10000); // the reader starts from the next record
+
+    // the sequence number of the pass is also its temperature and status values (they are checked by the reader)
+    for (uint32_t i = 0; i < PASSES; ++i) {
+        pass = (uint16_t) (dev.sequence + 1);
+        STTS22H_Linux_read(&dev);
+    }
+    atomic_store(&state.isRunning, false);
+    pthread_join(thread, NULL);
+
+    uint32_t published = PASSES * dev.number;
+    CHECK(state.received != 0);
+    CHECK(state.torn == 0);
+    CHECK(state.unordered == 0);
+    CHECK(state.received + state.lost == published);
+    printf("ring: published %lu, received %lu, lost %lu, torn %lu\n", (unsigned long) published,
+           (unsigned long) state.received, (unsigned long) state.lost, (unsigned long) state.torn);
+
+    STTS22H_Linux_close(&dev);
+    shm_unlink(name);
+}
+
+int main(void) {
+    testTransfer();
+    testRing();
+
+    if (failures != 0) {
+        printf("%u checks failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
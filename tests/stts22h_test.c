@@ -0,0 +1,559 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "stts22h.h"
+#include "stts22h_bus.h"
+#include "stts22h_static.h"
+
+// checks of the bus cost and the state machine on the simulated I2C bus (tests/mock/i2c.c),
+// the process is failed (ctest), if a budget of stts22h.h or a transaction step is broken
+
+static const uint32_t TICK = 10; // us, period of the application loop
+static const uint32_t LATENCY = 20; // us, start of every transfer
+static const uint32_t INSTANT = 1000; // us, every transfer is finished before the next update call
+static const uint32_t DURATION = 1000000; // us, simulated time of the periodic modes
+static const uint32_t SAMPLES = 200; // number of the measurements of the manual mode
+static const int16_t TEMP = 2537; // 0.01C
+
+// freerun 200Hz, IF_ADD_INC, BDU
+static const uint8_t CONTROL = 0x7C;
+
+static unsigned failures = 0;
+
+#define CHECK(condition) check((condition), #condition, __LINE__)
+
+/**
+ * @brief Report the failed check
+ * @param isPassed is the result of the check
+ * @param text is the checked expression
+ * @param line is the source line
+ */
+static void check(bool isPassed, const char *text, int line) {
+    if (!isPassed) {
+        printf("%s:%d: check failed: %s\n", __FILE__, line, text);
+        failures++;
+    }
+}
+
+/**
+ * @brief Prepare the simulated bus with one sensor
+ * @param i2c is the I2C interface data structure
+ * @param stts is the STTS22H data structure
+ * @param speed is the SCL frequency (Hz)
+ * @param latency is the start of every transfer (us)
+ */
+static void setup(I2CDef *i2c, STTS22H_Def *stts, uint32_t speed, uint32_t latency) {
+    I2C_Mock_setTime(0);
+    I2C_Mock_init(i2c, speed, latency);
+    I2C_Mock_addDevice(i2c, STTS22H_ADDRESS_0, TEMP);
+    STTS22H_init(stts, i2c, STTS22H_ADDRESS(STTS22H_ADDRESS_0));
+    STTS22H_setTimeSource(stts, I2C_Mock_getTime);
+}
+
+/**
+ * @brief Call STTS22H_update until the end of the transaction
+ * @param stts is the STTS22H data structure
+ * @param step is the simulated time between the update calls (us)
+ * @return number of the update calls
+ */
+static uint32_t finish(STTS22H_Def *stts, uint32_t step) {
+    uint32_t updates = 0;
+    while (STTS22H_isBusy(stts) && updates < 100000) {
+        I2C_Mock_advance(stts->i2c, step);
+        STTS22H_update(stts);
+        updates++;
+    }
+    return updates;
+}
+
+/**
+ * @brief STTS22H_measure: bus bytes per sample and update calls per transaction
+ */
+static void testMeasure(void) {
+    static const uint32_t SPEEDS[] = {I2C_MOCK_STANDARD, I2C_MOCK_FAST, I2C_MOCK_FAST_PLUS};
+
+    for (size_t s = 0; s < sizeof(SPEEDS) / sizeof(SPEEDS[0]); ++s) {
+        static I2CDef i2c;
+        STTS22H_Def stts;
+        setup(&i2c, &stts, SPEEDS[s], LATENCY);
+        CHECK(STTS22H_setting(&stts, CONTROL) == STTS22H_SUCCESS);
+
+        I2C_MockStats_Def stats = i2c.stats;
+        uint32_t updates = 0;
+        for (uint32_t i = 0; i < SAMPLES; ++i) {
+            CHECK(STTS22H_measure(&stts) == STTS22H_SUCCESS);
+            while (STTS22H_isBusy(&stts) && updates < 100000) {
+                STTS22H_update(&stts);
+                updates++;
+                I2C_Mock_advance(&i2c, TICK);
+            }
+        }
+
+        CHECK(stts.sequence == SAMPLES);
+        CHECK(STTS22H_getResult(&stts) == STTS22H_SUCCESS);
+        CHECK(stts.temp == TEMP);
+        CHECK(i2c.stats.bytes - stats.bytes == SAMPLES * STTS22H_BUDGET_MEASURE_BYTES);
+        CHECK(i2c.stats.transfers - stats.transfers == SAMPLES * 2); // the register address and the values
+        CHECK(i2c.stats.nacks == stats.nacks);
+    }
+
+    // every transfer is finished before the next call: one call per transfer
+    static I2CDef i2c;
+    STTS22H_Def stts;
+    setup(&i2c, &stts, I2C_MOCK_FAST, 0);
+    CHECK(STTS22H_setting(&stts, CONTROL) == STTS22H_SUCCESS);
+    for (uint32_t i = 0; i < SAMPLES; ++i) {
+        CHECK(STTS22H_measure(&stts) == STTS22H_SUCCESS);
+        CHECK(finish(&stts, INSTANT) == 2);
+    }
+    CHECK(stts.sequence == SAMPLES);
+}
+
+/**
+ * @brief One-shot mode: the "one_shot" bit write and the reading of every sample
+ */
+static void testOneShot(void) {
+    static const uint32_t PERIOD = 50000; // us
+
+    static I2CDef i2c;
+    STTS22H_Def stts;
+    setup(&i2c, &stts, I2C_MOCK_FAST, LATENCY);
+    CHECK(STTS22H_setting(&stts, (uint8_t) (CONTROL & ~0x04)) == STTS22H_SUCCESS); // power-down, IF_ADD_INC
+
+    I2C_MockStats_Def stats = i2c.stats;
+    CHECK(STTS22H_startOneShot(&stts, PERIOD) == STTS22H_SUCCESS);
+    while (I2C_Mock_getTime() < DURATION) {
+        STTS22H_update(&stts);
+        I2C_Mock_advance(&i2c, TICK);
+    }
+    STTS22H_stopOneShot(&stts);
+    finish(&stts, TICK);
+
+    uint32_t bytes = i2c.stats.bytes - stats.bytes;
+    CHECK(stts.sequence >= DURATION / PERIOD - 1);
+    CHECK(stts.temp == TEMP);
+    CHECK(bytes <= stts.sequence * STTS22H_BUDGET_ONE_SHOT_BYTES + STTS22H_BUDGET_ONE_SHOT_BYTES); // started one
+    CHECK(i2c.stats.nacks == stats.nacks);
+}
+
+/**
+ * @brief Streaming mode: only the temperature registers are read after the setup
+ */
+static void testStreaming(void) {
+    static I2CDef i2c;
+    STTS22H_Def stts;
+    setup(&i2c, &stts, I2C_MOCK_FAST, LATENCY);
+    CHECK(STTS22H_setting(&stts, (uint8_t) (CONTROL & ~0x04)) == STTS22H_SUCCESS);
+    CHECK(STTS22H_startStreaming(&stts, STTS22H_AVG_200Hz) == STTS22H_SUCCESS);
+
+    // the setup (CTRL write) and the first sample
+    while (stts.sequence == 0 && I2C_Mock_getTime() < DURATION) {
+        STTS22H_update(&stts);
+        I2C_Mock_advance(&i2c, TICK);
+    }
+    CHECK(STTS22H_getSettingResult(&stts) == STTS22H_SUCCESS);
+    CHECK(I2C_Mock_getDevice(&i2c, STTS22H_ADDRESS_0)->regs[0x04] & 0x04); // freerun
+
+    uint16_t sequence = stts.sequence;
+    I2C_MockStats_Def stats = i2c.stats;
+    uint32_t startTime = I2C_Mock_getTime();
+    while (I2C_Mock_getTime() - startTime < DURATION) {
+        STTS22H_update(&stts);
+        I2C_Mock_advance(&i2c, TICK);
+    }
+    STTS22H_stopStreaming(&stts);
+    finish(&stts, TICK);
+
+    uint32_t samples = (uint16_t) (stts.sequence - sequence);
+    CHECK(samples >= 195 && samples <= 201); // 200Hz
+    CHECK(stts.temp == TEMP);
+    CHECK(i2c.stats.bytes - stats.bytes == samples * STTS22H_BUDGET_STREAMING_BYTES);
+    CHECK(i2c.stats.nacks == stats.nacks);
+}
+
+/**
+ * @brief The streaming samples don't carry the threshold bits of the previous STATUS reading
+ */
+static void testStreamingStatus(void) {
+    static I2CDef i2c;
+    STTS22H_Def stts;
+    setup(&i2c, &stts, I2C_MOCK_FAST, 0);
+    CHECK(STTS22H_configureAsync(&stts, CONTROL, -1984, 1984, true) == STTS22H_SUCCESS); // TEMP is over the limit
+    finish(&stts, INSTANT);
+    I2C_Mock_advance(&i2c, 10000);
+
+    CHECK(STTS22H_measure(&stts) == STTS22H_SUCCESS);
+    finish(&stts, INSTANT);
+    STTS22H_Sample_Def sample;
+    CHECK(STTS22H_getSample(&stts, &sample) && sample.status.fields.over_thh);
+    CHECK(STTS22H_isOverheated(&stts));
+
+    CHECK(STTS22H_startStreaming(&stts, STTS22H_AVG_200Hz) == STTS22H_SUCCESS);
+    uint16_t sequence = stts.sequence;
+    for (uint32_t i = 0; i < 1000 && (uint16_t) (stts.sequence - sequence) < 3; ++i) {
+        I2C_Mock_advance(&i2c, 100);
+        STTS22H_update(&stts);
+    }
+    STTS22H_stopStreaming(&stts);
+    CHECK(STTS22H_getSample(&stts, &sample) && sample.status.full == 0);
+    CHECK(!STTS22H_isOverheated(&stts));
+}
+
+/**
+ * @brief Bus scheduler of four addresses: bus bytes per sample and update calls per transaction
+ */
+static void testBus(void) {
+    static const uint8_t ADDRESSES[] = {STTS22H_ADDRESS_0, STTS22H_ADDRESS_1, STTS22H_ADDRESS_2, STTS22H_ADDRESS_3};
+    static I2CDef i2c;
+    STTS22H_Def sensors[STTS22H_BUS_ADDRESSES];
+    STTS22H_Bus_Def bus;
+
+    I2C_Mock_setTime(0);
+    I2C_Mock_init(&i2c, I2C_MOCK_FAST, 0);
+    CHECK(STTS22H_Bus_init(&bus, &i2c) == STTS22H_SUCCESS);
+    STTS22H_Bus_setTimeSource(&bus, I2C_Mock_getTime);
+    for (uint8_t i = 0; i < STTS22H_BUS_ADDRESSES; ++i) {
+        I2C_Mock_addDevice(&i2c, ADDRESSES[i], (int16_t) (TEMP + i));
+        STTS22H_init(&sensors[i], &i2c, STTS22H_ADDRESS(ADDRESSES[i]));
+        STTS22H_setTimeSource(&sensors[i], I2C_Mock_getTime);
+        CHECK(STTS22H_setting(&sensors[i], CONTROL) == STTS22H_SUCCESS);
+        CHECK(STTS22H_Bus_addSensor(&bus, &sensors[i]) == STTS22H_SUCCESS);
+    }
+
+    I2C_MockStats_Def stats = i2c.stats;
+    uint32_t updates = 0;
+    for (uint32_t i = 0; i < SAMPLES / STTS22H_BUS_ADDRESSES; ++i) {
+        CHECK(STTS22H_Bus_measureAll(&bus) == STTS22H_SUCCESS);
+        while (STTS22H_Bus_isBusy(&bus) && updates < 100000) {
+            I2C_Mock_advance(&i2c, INSTANT);
+            STTS22H_Bus_update(&bus);
+            updates++;
+        }
+    }
+
+    uint32_t samples = 0;
+    for (uint8_t i = 0; i < STTS22H_BUS_ADDRESSES; ++i) {
+        samples += sensors[i].sequence;
+        CHECK(sensors[i].temp == TEMP + i);
+    }
+    CHECK(samples == SAMPLES);
+    CHECK(i2c.stats.bytes - stats.bytes == samples * STTS22H_BUDGET_MEASURE_BYTES);
+    CHECK(i2c.stats.transfers - stats.transfers == samples * 2);
+    CHECK(updates <= samples * 3); // two transfers per sample and the start of the next request
+}
+
+/**
+ * @brief The periodic mode of a sensor is its own work: the scheduler isn't busy, the sensors can be added
+ */
+static void testBusPending(void) {
+    static I2CDef i2c;
+    STTS22H_Def sensors[2];
+    STTS22H_Bus_Def bus;
+
+    I2C_Mock_setTime(0);
+    I2C_Mock_init(&i2c, I2C_MOCK_FAST, 0);
+    CHECK(STTS22H_Bus_init(&bus, &i2c) == STTS22H_SUCCESS);
+    STTS22H_Bus_setTimeSource(&bus, I2C_Mock_getTime);
+    I2C_Mock_addDevice(&i2c, STTS22H_ADDRESS_0, TEMP);
+    I2C_Mock_addDevice(&i2c, STTS22H_ADDRESS_1, TEMP);
+    STTS22H_init(&sensors[0], &i2c, STTS22H_ADDRESS(STTS22H_ADDRESS_0));
+    STTS22H_init(&sensors[1], &i2c, STTS22H_ADDRESS(STTS22H_ADDRESS_1));
+    STTS22H_setTimeSource(&sensors[0], I2C_Mock_getTime);
+    STTS22H_setTimeSource(&sensors[1], I2C_Mock_getTime);
+
+    CHECK(STTS22H_Bus_addSensor(&bus, &sensors[0]) == STTS22H_SUCCESS);
+    CHECK(STTS22H_startStreaming(&sensors[0], STTS22H_AVG_200Hz) == STTS22H_SUCCESS);
+    for (uint32_t i = 0; i < 100; ++i) {
+        STTS22H_Bus_update(&bus);
+        I2C_Mock_advance(&i2c, 100);
+    }
+    CHECK(sensors[0].sequence != 0);
+    CHECK(STTS22H_Bus_isPending(&bus));
+
+    // the streaming transaction is finished, the second sensor is added between the readings
+    while (STTS22H_Bus_isBusy(&bus)) {
+        I2C_Mock_advance(&i2c, 100);
+        STTS22H_Bus_update(&bus);
+    }
+    CHECK(STTS22H_Bus_addSensor(&bus, &sensors[1]) == STTS22H_SUCCESS);
+    CHECK(STTS22H_Bus_setting(&bus, 1, CONTROL) == STTS22H_SUCCESS);
+    CHECK(STTS22H_Bus_measure(&bus, 1) == STTS22H_SUCCESS);
+    uint16_t sequence = sensors[0].sequence;
+    for (uint32_t i = 0; i < 1000; ++i) { // 100 ms
+        I2C_Mock_advance(&i2c, 100);
+        STTS22H_Bus_update(&bus);
+        if (!STTS22H_Bus_isBusy(&bus))
+            STTS22H_Bus_measure(&bus, 1);
+    }
+    CHECK(sensors[1].sequence != 0 && sensors[1].temp == TEMP);
+    CHECK((uint16_t) (sensors[0].sequence - sequence) >= 15); // 200Hz, the streaming is serviced too
+}
+
+static uint8_t lastRegAddr;
+
+/**
+ * @brief Start reading of the default transport, the register address is recorded (e.g. SMBus PEC)
+ */
+static int recordRead(I2CDef *i2c, uint8_t devAddr, uint8_t regAddr, uint8_t dataSize) {
+    lastRegAddr = regAddr;
+    return STTS22H_I2C_TRANSPORT.read(i2c, devAddr, regAddr, dataSize);
+}
+
+/**
+ * @brief The reading of the transport gets the register address of its transaction
+ */
+static void testTransport(void) {
+    STTS22H_Transport_Def transport = STTS22H_I2C_TRANSPORT;
+    transport.read = recordRead;
+    transport.writeRead = NULL;
+    transport.readInto = NULL;
+
+    static I2CDef i2c;
+    STTS22H_Def stts;
+    setup(&i2c, &stts, I2C_MOCK_FAST, 0);
+    CHECK(STTS22H_setTransport(&stts, &transport) == STTS22H_SUCCESS);
+    CHECK(STTS22H_setting(&stts, CONTROL) == STTS22H_SUCCESS);
+
+    CHECK(STTS22H_checkConnection(&stts) == STTS22H_SUCCESS);
+    finish(&stts, INSTANT);
+    CHECK(lastRegAddr == 0x01); // WHOAMI
+    CHECK(STTS22H_isConnected(&stts));
+
+    I2C_Mock_advance(&i2c, 10000); // the first conversion of freerun mode
+    CHECK(STTS22H_measure(&stts) == STTS22H_SUCCESS);
+    finish(&stts, INSTANT);
+    CHECK(lastRegAddr == 0x05); // STATUS
+    CHECK(stts.temp == TEMP);
+}
+
+/**
+ * @brief Combined transfer of the transport (DMA HAL of the mock)
+ */
+static int mockWriteRead(I2CDef *i2c, uint8_t devAddr, const uint8_t *regAddr, uint8_t *data, uint8_t dataSize) {
+    return I2C_Mock_writeRead(i2c, devAddr, *regAddr, data, dataSize);
+}
+
+/**
+ * @brief Zero-copy reading of the transport (DMA HAL of the mock)
+ */
+static int mockReadInto(I2CDef *i2c, uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint8_t dataSize) {
+    (void) regAddr; // it has been written by the previous transfer
+    return I2C_Mock_readInto(i2c, devAddr, data, dataSize);
+}
+
+/**
+ * @brief STTS22H_measure with the optional transfers of the transport: the values are taken from the buffer
+ * of the driver (the buffer of the interface is filled with garbage)
+ * @param isCombined is a flag (True - the combined transfer, False - the register address and the zero-copy reading)
+ */
+static void checkDmaTransport(bool isCombined) {
+    STTS22H_Transport_Def transport = STTS22H_I2C_TRANSPORT;
+    transport.writeRead = isCombined ? mockWriteRead : NULL;
+    transport.readInto = isCombined ? NULL : mockReadInto;
+
+    static I2CDef i2c;
+    STTS22H_Def stts;
+    setup(&i2c, &stts, I2C_MOCK_FAST, LATENCY);
+    I2C_MockDevice_Def *dev = I2C_Mock_getDevice(&i2c, STTS22H_ADDRESS_0);
+    CHECK(STTS22H_setTransport(&stts, &transport) == STTS22H_SUCCESS);
+    CHECK(STTS22H_setting(&stts, CONTROL) == STTS22H_SUCCESS);
+    CHECK(STTS22H_checkConnection(&stts) == STTS22H_SUCCESS);
+    finish(&stts, INSTANT);
+    CHECK(STTS22H_isConnected(&stts));
+    I2C_Mock_advance(&i2c, 10000); // the first conversion of freerun mode
+
+    uint32_t transfersPerSample = isCombined ? 1 : 2;
+    I2C_MockStats_Def stats = i2c.stats;
+    uint32_t updates = 0;
+    for (uint32_t i = 0; i < SAMPLES; ++i) {
+        memset(i2c.rxData, 0xFF, sizeof(i2c.rxData));
+        CHECK(STTS22H_measure(&stts) == STTS22H_SUCCESS);
+        updates += finish(&stts, INSTANT);
+        CHECK(STTS22H_getResult(&stts) == STTS22H_SUCCESS);
+    }
+    CHECK(stts.sequence == SAMPLES);
+    CHECK(stts.temp == TEMP);
+    CHECK(updates == SAMPLES * transfersPerSample);
+    CHECK(i2c.stats.transfers - stats.transfers == SAMPLES * transfersPerSample);
+    CHECK(i2c.stats.bytes - stats.bytes == SAMPLES * STTS22H_BUDGET_MEASURE_BYTES);
+
+    // the device address isn't acknowledged: the reading is failed, the sample isn't taken
+    dev->nacks = 1;
+    CHECK(STTS22H_measure(&stts) == STTS22H_SUCCESS);
+    finish(&stts, INSTANT);
+    CHECK(STTS22H_getResult(&stts) != STTS22H_SUCCESS);
+    CHECK(stts.sequence == SAMPLES);
+}
+
+/**
+ * @brief The repeated START transfer (one transfer per reading) and the zero-copy reading of the transport
+ */
+static void testDmaTransport(void) {
+    checkDmaTransport(true);
+    checkDmaTransport(false);
+}
+
+/**
+ * @brief Registers of the sensor without IF_ADD_INC are written one by one, CTRL is the first
+ */
+static void testAutoIncrement(void) {
+    // the thresholds are multiples of 0.64C (one register step)
+    static I2CDef i2c;
+    STTS22H_Def stts;
+    setup(&i2c, &stts, I2C_MOCK_FAST, 0);
+    I2C_MockDevice_Def *dev = I2C_Mock_getDevice(&i2c, STTS22H_ADDRESS_0);
+
+    // without IF_ADD_INC: three transactions
+    uint32_t transfers = i2c.stats.transfers;
+    CHECK(STTS22H_configureAsync(&stts, (uint8_t) (CONTROL & ~0x08), -1024, 4992, true) == STTS22H_SUCCESS);
+    finish(&stts, INSTANT);
+    CHECK(STTS22H_getSettingResult(&stts) == STTS22H_SUCCESS);
+    CHECK(i2c.stats.transfers - transfers == 3);
+    CHECK(dev->regs[0x04] == (uint8_t) (CONTROL & ~0x08));
+    CHECK(dev->regs[0x02] == 4992 / 64 + 63);
+    CHECK(dev->regs[0x03] == -1024 / 64 + 63);
+
+    // with IF_ADD_INC: CTRL alone (the address increment isn't known yet), then one burst of the thresholds
+    STTS22H_invalidateCache(&stts);
+    transfers = i2c.stats.transfers;
+    CHECK(STTS22H_configureAsync(&stts, CONTROL, -1984, 5952, true) == STTS22H_SUCCESS);
+    finish(&stts, INSTANT);
+    CHECK(STTS22H_getSettingResult(&stts) == STTS22H_SUCCESS);
+    CHECK(i2c.stats.transfers - transfers == 2);
+    CHECK(dev->regs[0x04] == CONTROL);
+    CHECK(dev->regs[0x02] == 5952 / 64 + 63);
+    CHECK(dev->regs[0x03] == -1984 / 64 + 63);
+
+    // the cached values aren't written again
+    transfers = i2c.stats.transfers;
+    CHECK(STTS22H_configureAsync(&stts, CONTROL, -1984, 5952, true) == STTS22H_SUCCESS);
+    finish(&stts, INSTANT);
+    CHECK(i2c.stats.transfers == transfers);
+}
+
+/**
+ * @brief The transfer, that hasn't been acknowledged, finishes the transaction with the error
+ */
+static void testNack(void) {
+    static I2CDef i2c;
+    STTS22H_Def stts;
+    setup(&i2c, &stts, I2C_MOCK_FAST, 0);
+    I2C_MockDevice_Def *dev = I2C_Mock_getDevice(&i2c, STTS22H_ADDRESS_0);
+    CHECK(STTS22H_setting(&stts, CONTROL) == STTS22H_SUCCESS);
+
+    CHECK(STTS22H_checkConnection(&stts) == STTS22H_SUCCESS);
+    finish(&stts, INSTANT);
+    CHECK(STTS22H_isConnected(&stts));
+
+    // the register address isn't acknowledged: stale data isn't taken
+    dev->nacks = 1;
+    CHECK(STTS22H_measure(&stts) == STTS22H_SUCCESS);
+    finish(&stts, INSTANT);
+    CHECK(STTS22H_getResult(&stts) != STTS22H_SUCCESS);
+    CHECK(stts.sequence == 0);
+
+    dev->nacks = 1;
+    CHECK(STTS22H_checkConnection(&stts) == STTS22H_SUCCESS);
+    finish(&stts, INSTANT);
+    CHECK(!STTS22H_isConnected(&stts));
+
+    CHECK(STTS22H_measure(&stts) == STTS22H_SUCCESS);
+    finish(&stts, INSTANT);
+    CHECK(STTS22H_getResult(&stts) == STTS22H_SUCCESS);
+    CHECK(stts.sequence == 1);
+    CHECK(stts.temp == TEMP);
+}
+
+/**
+ * @brief Interrupt mode: STTS22H_transferComplete finishes the transaction, STTS22H_update starts the next one
+ */
+static void testInterrupt(void) {
+    static I2CDef i2c;
+    STTS22H_Def stts;
+    setup(&i2c, &stts, I2C_MOCK_FAST, 0);
+    CHECK(STTS22H_setting(&stts, CONTROL) == STTS22H_SUCCESS);
+    CHECK(STTS22H_setInterruptMode(&stts, true) == STTS22H_SUCCESS);
+    I2C_Mock_advance(&i2c, 10000);
+
+    CHECK(STTS22H_measure(&stts) == STTS22H_SUCCESS);
+    STTS22H_update(&stts); // the transaction is started by the main loop
+    // the setup of the streaming (CTRL write) is pending: the interrupt handler doesn't start it
+    CHECK(STTS22H_startStreaming(&stts, STTS22H_AVG_25Hz) == STTS22H_SUCCESS);
+    for (uint32_t i = 0; i < 20; ++i) {
+        I2C_Mock_advance(&i2c, INSTANT);
+        STTS22H_transferComplete(&stts);
+    }
+    CHECK(!STTS22H_isBusy(&stts));
+    CHECK(stts.sequence == 1 && stts.temp == TEMP);
+    CHECK(I2C_Mock_getDevice(&i2c, STTS22H_ADDRESS_0)->regs[0x04] == CONTROL);
+    uint32_t transfers = i2c.stats.transfers;
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        I2C_Mock_advance(&i2c, INSTANT);
+        STTS22H_update(&stts);
+        STTS22H_transferComplete(&stts);
+    }
+    STTS22H_stopStreaming(&stts);
+    CHECK(i2c.stats.transfers != transfers);
+    CHECK(stts.sequence > 1 && stts.temp == TEMP);
+}
+
+static I2CDef staticBus;
+STTS22H_STATIC_DEFINE(staticSensor, &staticBus, STTS22H_ADDRESS(STTS22H_ADDRESS_0))
+
+/**
+ * @brief Specialized driver: the reading isn't started, if the register address hasn't been acknowledged
+ */
+static void testStatic(void) {
+    I2C_Mock_setTime(0);
+    I2C_Mock_init(&staticBus, I2C_MOCK_FAST, 0);
+    I2C_MockDevice_Def *dev = I2C_Mock_addDevice(&staticBus, STTS22H_ADDRESS_0, TEMP);
+    const uint8_t control[] = {STTS22H_CTRL_ADDR, CONTROL};
+    CHECK(I2C_writeData(&staticBus, STTS22H_ADDRESS(STTS22H_ADDRESS_0), control, sizeof(control), true) == I2C_SUCCESS);
+    I2C_Mock_advance(&staticBus, 10000); // the first conversion of freerun mode
+
+    CHECK(staticSensor_measure() == STTS22H_SUCCESS);
+    for (uint32_t i = 0; i < 10 && staticSensor_isBusy(); ++i) {
+        I2C_Mock_advance(&staticBus, INSTANT);
+        staticSensor_update();
+    }
+    CHECK(!staticSensor_isBusy());
+    CHECK(staticSensor_getTemp_cC() == TEMP);
+
+    dev->nacks = 1;
+    dev->temp = TEMP + 100;
+    I2C_Mock_advance(&staticBus, 10000);
+    uint32_t transfers = staticBus.stats.transfers;
+    CHECK(staticSensor_measure() == STTS22H_SUCCESS);
+    for (uint32_t i = 0; i < 10 && staticSensor_isBusy(); ++i) {
+        I2C_Mock_advance(&staticBus, INSTANT);
+        staticSensor_update();
+    }
+    CHECK(!staticSensor_isBusy());
+    CHECK(staticBus.stats.transfers - transfers == 1); // only the register address
+    CHECK(staticSensor_getTemp_cC() == TEMP);
+}
+
+int main(void) {
+    testMeasure();
+    testOneShot();
+    testStreaming();
+    testStreamingStatus();
+    testBus();
+    testBusPending();
+    testTransport();
+    testDmaTransport();
+    testAutoIncrement();
+    testNack();
+    testInterrupt();
+    testStatic();
+
+    printf("sizeof(STTS22H_Def) %lu, budget %lu bytes\n", (unsigned long) sizeof(STTS22H_Def),
+           (unsigned long) STTS22H_BUDGET_DATA_SIZE);
+    if (failures != 0) {
+        printf("%u checks failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}